@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "accumulator.hpp"
+#include "common.hpp"
+
+
+constexpr uint32_t dot_product_size = 64;
+
+
+template<uint32_t N>
+void BM_dot_product_operators(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    std::vector<lrf::_uint<N>> a, b;
+    for(uint32_t i(0); i < dot_product_size; ++i)
+    {
+        a.push_back(random_uint<N>(gen));
+        b.push_back(random_uint<N>(gen));
+    }
+    for(auto _ : state)
+    {
+        lrf::_uint<N> sum(0);
+        for(uint32_t i(0); i < dot_product_size; ++i)
+            sum += a[i]*b[i];
+        benchmark::DoNotOptimize(sum.value);
+    }
+}
+
+
+template<uint32_t N>
+void BM_dot_product_accumulator(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    std::vector<lrf::_uint<N>> a, b;
+    for(uint32_t i(0); i < dot_product_size; ++i)
+    {
+        a.push_back(random_uint<N>(gen));
+        b.push_back(random_uint<N>(gen));
+    }
+    lrf::_uint_accumulator<N> acc;
+    for(auto _ : state)
+    {
+        acc.reset();
+        for(uint32_t i(0); i < dot_product_size; ++i)
+            acc.add_product(a[i],b[i]);
+        lrf::_uint<N> sum = acc.finalize();
+        benchmark::DoNotOptimize(sum.value);
+    }
+}
+
+
+BENCHMARK(BM_dot_product_operators<256>);
+BENCHMARK(BM_dot_product_accumulator<256>);
+BENCHMARK(BM_dot_product_operators<1024>);
+BENCHMARK(BM_dot_product_accumulator<1024>);
+BENCHMARK(BM_dot_product_operators<4096>);
+BENCHMARK(BM_dot_product_accumulator<4096>);
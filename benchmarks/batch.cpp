@@ -0,0 +1,190 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "batch.hpp"
+#include "common.hpp"
+
+
+constexpr uint32_t batch_size = 4096;
+
+
+template<uint32_t N>
+void BM_multiply_loop(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    std::vector<lrf::_uint<N>> a, b, res(batch_size);
+    for(uint32_t i(0); i < batch_size; ++i)
+    {
+        a.push_back(random_uint<N>(gen));
+        b.push_back(random_uint<N>(gen));
+    }
+    for(auto _ : state)
+    {
+        for(uint32_t i(0); i < batch_size; ++i)
+            res[i] = a[i]*b[i];
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations()*batch_size);
+}
+
+
+template<uint32_t N>
+void BM_multiply_batch(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    std::vector<lrf::_uint<N>> a, b, res(batch_size);
+    for(uint32_t i(0); i < batch_size; ++i)
+    {
+        a.push_back(random_uint<N>(gen));
+        b.push_back(random_uint<N>(gen));
+    }
+    lrf::_thread_pool pool(state.range(0));
+    for(auto _ : state)
+    {
+        lrf::multiply_batch(std::span<const lrf::_uint<N>>(a),std::span<const lrf::_uint<N>>(b),std::span<lrf::_uint<N>>(res),pool);
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations()*batch_size);
+}
+
+
+template<uint32_t N>
+void BM_add_loop(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    std::vector<lrf::_uint<N>> a, b, res(batch_size);
+    for(uint32_t i(0); i < batch_size; ++i)
+    {
+        a.push_back(random_uint<N>(gen));
+        b.push_back(random_uint<N>(gen));
+    }
+    for(auto _ : state)
+    {
+        for(uint32_t i(0); i < batch_size; ++i)
+            res[i] = a[i]+b[i];
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations()*batch_size);
+}
+
+
+template<uint32_t N>
+void BM_add_batch(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    std::vector<lrf::_uint<N>> a, b, res(batch_size);
+    for(uint32_t i(0); i < batch_size; ++i)
+    {
+        a.push_back(random_uint<N>(gen));
+        b.push_back(random_uint<N>(gen));
+    }
+    lrf::_thread_pool pool(state.range(0));
+    for(auto _ : state)
+    {
+        lrf::add_batch(std::span<const lrf::_uint<N>>(a),std::span<const lrf::_uint<N>>(b),std::span<lrf::_uint<N>>(res),pool);
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations()*batch_size);
+}
+
+
+template<uint32_t N>
+void BM_subtract_loop(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    std::vector<lrf::_uint<N>> a, b, res(batch_size);
+    for(uint32_t i(0); i < batch_size; ++i)
+    {
+        a.push_back(random_uint<N>(gen));
+        b.push_back(random_uint<N>(gen));
+    }
+    for(auto _ : state)
+    {
+        for(uint32_t i(0); i < batch_size; ++i)
+            res[i] = a[i]-b[i];
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations()*batch_size);
+}
+
+
+template<uint32_t N>
+void BM_subtract_batch(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    std::vector<lrf::_uint<N>> a, b, res(batch_size);
+    for(uint32_t i(0); i < batch_size; ++i)
+    {
+        a.push_back(random_uint<N>(gen));
+        b.push_back(random_uint<N>(gen));
+    }
+    lrf::_thread_pool pool(state.range(0));
+    for(auto _ : state)
+    {
+        lrf::subtract_batch(std::span<const lrf::_uint<N>>(a),std::span<const lrf::_uint<N>>(b),std::span<lrf::_uint<N>>(res),pool);
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations()*batch_size);
+}
+
+
+// Modular exponentiations are long enough that a small batch already fills the threads
+constexpr uint32_t modexp_batch_size = 64;
+
+
+template<uint32_t N>
+void BM_modexp_loop(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    std::vector<lrf::_uint<N>> base, exp, res(modexp_batch_size);
+    lrf::_uint<N> m = random_uint<N>(gen);
+    m.value[0] |= 1;
+    for(uint32_t i(0); i < modexp_batch_size; ++i)
+    {
+        base.push_back(random_uint<N>(gen));
+        exp.push_back(random_uint<N>(gen));
+    }
+    for(auto _ : state)
+    {
+        for(uint32_t i(0); i < modexp_batch_size; ++i)
+            res[i] = lrf::modexp(base[i],exp[i],m);
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations()*modexp_batch_size);
+}
+
+
+template<uint32_t N>
+void BM_modexp_batch(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    std::vector<lrf::_uint<N>> base, exp, res(modexp_batch_size);
+    lrf::_uint<N> m = random_uint<N>(gen);
+    m.value[0] |= 1;
+    for(uint32_t i(0); i < modexp_batch_size; ++i)
+    {
+        base.push_back(random_uint<N>(gen));
+        exp.push_back(random_uint<N>(gen));
+    }
+    lrf::_thread_pool pool(state.range(0));
+    for(auto _ : state)
+    {
+        lrf::modexp_batch(std::span<const lrf::_uint<N>>(base),std::span<const lrf::_uint<N>>(exp),m,std::span<lrf::_uint<N>>(res),pool);
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations()*modexp_batch_size);
+}
+
+
+BENCHMARK(BM_multiply_loop<1024>);
+BENCHMARK(BM_multiply_batch<1024>)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK(BM_multiply_loop<2048>);
+BENCHMARK(BM_multiply_batch<2048>)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK(BM_add_loop<1024>);
+BENCHMARK(BM_add_batch<1024>)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK(BM_subtract_loop<1024>);
+BENCHMARK(BM_subtract_batch<1024>)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK(BM_modexp_loop<512>);
+BENCHMARK(BM_modexp_batch<512>)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK(BM_modexp_loop<1024>);
+BENCHMARK(BM_modexp_batch<1024>)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
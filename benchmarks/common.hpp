@@ -0,0 +1,18 @@
+#ifndef LRF_BENCHMARKS_COMMON_HPP
+#define LRF_BENCHMARKS_COMMON_HPP
+
+#include <random>
+#include "uint.hpp"
+
+
+// Uniformly random value over the whole width of _uint<N>
+template<uint32_t N>
+lrf::_uint<N> random_uint(std::mt19937_64& gen)
+{
+    lrf::_uint<N> res;
+    for(uint32_t i(0); i < lrf::_uint<N>::words_num; ++i)
+        res.value[i] = gen();
+    return res;
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "exponentiation.hpp"
+#include "common.hpp"
+
+
+template<uint32_t N>
+void BM_modexp(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> base = random_uint<N>(gen), exp = random_uint<N>(gen), m = random_uint<N>(gen);
+    m.value[0] |= 1;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(lrf::modexp(base,exp,m).value);
+}
+
+
+template<uint32_t N>
+void BM_fixed_base_modexp(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> base = random_uint<N>(gen), exp = random_uint<N>(gen), m = random_uint<N>(gen);
+    m.value[0] |= 1;
+    lrf::_fixed_base_modexp<N> table(base,m,N);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(table.pow(exp).value);
+}
+
+
+template<uint32_t N>
+void BM_fixed_base_precompute(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> base = random_uint<N>(gen), m = random_uint<N>(gen);
+    m.value[0] |= 1;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(lrf::_fixed_base_modexp<N>(base,m,N).max_exp_bits());
+}
+
+
+// Product of state.range(0) powers, one modexp per term
+template<uint32_t N>
+void BM_multi_modexp_naive(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> m = random_uint<N>(gen);
+    m.value[0] |= 1;
+    std::vector<lrf::_uint<N>> bases, exps;
+    for(int64_t i(0); i < state.range(0); ++i)
+    {
+        bases.push_back(random_uint<N>(gen));
+        exps.push_back(random_uint<N>(gen));
+    }
+    for(auto _ : state)
+    {
+        lrf::_uint<2*N> res(1);
+        for(int64_t i(0); i < state.range(0); ++i)
+            res = (res*lrf::_uint<2*N>(lrf::modexp(bases[i],exps[i],m))) % lrf::_uint<2*N>(m);
+        benchmark::DoNotOptimize(res.value);
+    }
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+
+template<uint32_t N>
+void BM_multi_modexp(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> m = random_uint<N>(gen);
+    m.value[0] |= 1;
+    std::vector<lrf::_uint<N>> bases, exps;
+    for(int64_t i(0); i < state.range(0); ++i)
+    {
+        bases.push_back(random_uint<N>(gen));
+        exps.push_back(random_uint<N>(gen));
+    }
+    for(auto _ : state)
+        benchmark::DoNotOptimize(lrf::multi_modexp(std::span<const lrf::_uint<N>>(bases),std::span<const lrf::_uint<N>>(exps),m).value);
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+
+BENCHMARK(BM_modexp<1024>);
+BENCHMARK(BM_modexp<2048>);
+BENCHMARK(BM_fixed_base_modexp<1024>);
+BENCHMARK(BM_fixed_base_modexp<2048>);
+BENCHMARK(BM_fixed_base_precompute<1024>);
+BENCHMARK(BM_fixed_base_precompute<2048>);
+BENCHMARK(BM_multi_modexp_naive<1024>)->Arg(4)->Arg(64);
+BENCHMARK(BM_multi_modexp<1024>)->Arg(4)->Arg(16)->Arg(64)->Arg(1024);
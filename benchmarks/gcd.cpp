@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include "gcd.hpp"
+#include "common.hpp"
+
+
+// Textbook Euclid on the division operator, the baseline for Lehmer's gcd.
+template<uint32_t N>
+lrf::_uint<N> euclid_gcd(const lrf::_uint<N>& a, const lrf::_uint<N>& b)
+{
+    lrf::_uint<N> u(a),v(b);
+    while(v != lrf::_uint<N>(0))
+    {
+        lrf::_uint<N> r = u % v;
+        u = v;
+        v = r;
+    }
+    return u;
+}
+
+
+template<uint32_t N>
+void BM_euclid_gcd(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> a = random_uint<N>(gen), b = random_uint<N>(gen);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(euclid_gcd<N>(a,b));
+}
+
+
+template<uint32_t N>
+void BM_gcd(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> a = random_uint<N>(gen), b = random_uint<N>(gen);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(lrf::gcd(a,b));
+}
+
+
+template<uint32_t N>
+void BM_mod_inverse(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> a = random_uint<N>(gen), m = random_uint<N>(gen);
+    m.value[0] |= 1;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(lrf::mod_inverse(a,m));
+}
+
+
+template<uint32_t N>
+void BM_mod_inverse_ct(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> a = random_uint<N>(gen), m = random_uint<N>(gen);
+    m.value[0] |= 1;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(lrf::mod_inverse_ct(a,m));
+}
+
+
+BENCHMARK(BM_euclid_gcd<256>);
+BENCHMARK(BM_gcd<256>);
+BENCHMARK(BM_mod_inverse<256>);
+BENCHMARK(BM_mod_inverse_ct<256>);
+BENCHMARK(BM_euclid_gcd<1024>);
+BENCHMARK(BM_gcd<1024>);
+BENCHMARK(BM_mod_inverse<1024>);
+BENCHMARK(BM_mod_inverse_ct<1024>);
+BENCHMARK(BM_euclid_gcd<4096>);
+BENCHMARK(BM_gcd<4096>);
+BENCHMARK(BM_mod_inverse<4096>);
+BENCHMARK(BM_mod_inverse_ct<4096>);
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include "root.hpp"
+#include "common.hpp"
+
+
+// Newton's iteration at full precision from 2^ceil(bits/2), on _uint operators
+template<uint32_t N>
+lrf::_uint<N> isqrt_full_precision(const lrf::_uint<N>& a)
+{
+    uint32_t a_bits = lrf::__kernels::bit_length(a.value,lrf::_uint<N>::words_num);
+    lrf::_uint<N> x = lrf::_uint<N>(1) << (a_bits+1)/2;
+    while(true)
+    {
+        lrf::_uint<N> y = (x + a/x) >> 1;
+        if(!(y < x))
+            return x;
+        x = y;
+    }
+}
+
+
+template<uint32_t N>
+void BM_isqrt_full_precision(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> a = random_uint<N>(gen) >> 1;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(isqrt_full_precision(a).value);
+}
+
+
+template<uint32_t N>
+void BM_isqrt(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> a = random_uint<N>(gen);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(lrf::isqrt(a).value);
+}
+
+
+template<uint32_t N>
+void BM_iroot(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> a = random_uint<N>(gen);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(lrf::iroot(a,state.range(0)).value);
+}
+
+
+// Random operands, almost all rejected by the residue filter
+template<uint32_t N>
+void BM_is_perfect_square(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> a = random_uint<N>(gen);
+    for(auto _ : state)
+    {
+        ++a.value[0];
+        benchmark::DoNotOptimize(lrf::is_perfect_square(a));
+    }
+}
+
+
+BENCHMARK(BM_isqrt_full_precision<1024>);
+BENCHMARK(BM_isqrt_full_precision<8192>);
+BENCHMARK(BM_isqrt<1024>);
+BENCHMARK(BM_isqrt<2048>);
+BENCHMARK(BM_isqrt<4096>);
+BENCHMARK(BM_isqrt<8192>);
+BENCHMARK(BM_iroot<1024>)->Arg(3)->Arg(17);
+BENCHMARK(BM_iroot<8192>)->Arg(3)->Arg(17);
+BENCHMARK(BM_is_perfect_square<1024>);
+BENCHMARK(BM_is_perfect_square<8192>);
@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include "uint.hpp"
+#include "common.hpp"
+
+
+template<uint32_t N>
+void BM_add(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> a = random_uint<N>(gen), b = random_uint<N>(gen);
+    for(auto _ : state)
+    {
+        a += b;
+        benchmark::DoNotOptimize(a.value);
+    }
+}
+
+
+template<uint32_t N>
+void BM_sub(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> a = random_uint<N>(gen), b = random_uint<N>(gen);
+    for(auto _ : state)
+    {
+        a -= b;
+        benchmark::DoNotOptimize(a.value);
+    }
+}
+
+
+template<uint32_t N>
+void BM_mul(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> a = random_uint<N>(gen), b = random_uint<N>(gen);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(a*b);
+}
+
+
+// Full W x W word products through the fixed size Comba kernel and the blocked schoolbook
+// kernel, showing the crossover behind __globals::unrolled_kernels_bound.
+template<uint32_t W>
+void BM_mul_kernel_unrolled(benchmark::State& state)
+{
+    std::mt19937_64 gen(W);
+    lrf::_uint<W*16> a = random_uint<W*16>(gen), b = random_uint<W*16>(gen);
+    uint16_t res[2*W];
+    for(auto _ : state)
+    {
+        lrf::__kernels::mul_n<W>(res,a.value,b.value);
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+
+template<uint32_t W>
+void BM_mul_kernel_blocked(benchmark::State& state)
+{
+    std::mt19937_64 gen(W);
+    lrf::_uint<W*16> a = random_uint<W*16>(gen), b = random_uint<W*16>(gen);
+    uint16_t res[2*W];
+    for(auto _ : state)
+    {
+        lrf::__kernels::mul_blocked(res,a.value,W,b.value,W,2*W);
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+
+template<uint32_t N>
+void BM_hash(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> a = random_uint<N>(gen);
+    for(auto _ : state)
+    {
+        ++a.value[0];
+        benchmark::DoNotOptimize(std::hash<lrf::_uint<N>>()(a));
+    }
+}
+
+
+// Hashing the hex string, the way keys were hashed before std::hash<_uint>
+template<uint32_t N>
+void BM_hash_string(benchmark::State& state)
+{
+    std::mt19937_64 gen(N);
+    lrf::_uint<N> a = random_uint<N>(gen);
+    for(auto _ : state)
+    {
+        ++a.value[0];
+        benchmark::DoNotOptimize(std::hash<std::string>()((std::string)a));
+    }
+}
+
+
+BENCHMARK(BM_add<128>);
+BENCHMARK(BM_add<256>);
+BENCHMARK(BM_add<512>);
+BENCHMARK(BM_add<1024>);
+BENCHMARK(BM_sub<128>);
+BENCHMARK(BM_sub<256>);
+BENCHMARK(BM_sub<512>);
+BENCHMARK(BM_sub<1024>);
+BENCHMARK(BM_mul<128>);
+BENCHMARK(BM_mul<256>);
+BENCHMARK(BM_mul<512>);
+BENCHMARK(BM_mul<1024>);
+BENCHMARK(BM_mul<2048>);
+BENCHMARK(BM_mul<4096>);
+BENCHMARK(BM_mul<8192>);
+BENCHMARK(BM_mul<16384>);
+BENCHMARK(BM_mul<32768>);
+BENCHMARK(BM_mul_kernel_unrolled<8>);
+BENCHMARK(BM_mul_kernel_blocked<8>);
+BENCHMARK(BM_mul_kernel_unrolled<16>);
+BENCHMARK(BM_mul_kernel_blocked<16>);
+BENCHMARK(BM_mul_kernel_unrolled<32>);
+BENCHMARK(BM_mul_kernel_blocked<32>);
+BENCHMARK(BM_mul_kernel_unrolled<64>);
+BENCHMARK(BM_mul_kernel_blocked<64>);
+BENCHMARK(BM_hash<256>);
+BENCHMARK(BM_hash<1024>);
+BENCHMARK(BM_hash<4096>);
+BENCHMARK(BM_hash_string<256>);
+BENCHMARK(BM_hash_string<4096>);
@@ -0,0 +1,162 @@
+#ifndef LRF_ACCUMULATOR_HPP
+#define LRF_ACCUMULATOR_HPP
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "uint.hpp"
+
+namespace lrf
+{
+    // Carry-save accumulator for long sums and inner products modulo 2^N.
+    // Every 16 bit word gets a 64 bit limb, so add() and add_product() only add into limbs and
+    // never propagate carries. Carries are resolved by normalize(), which runs on its own when
+    // the next operation could take a limb past the capacity, and by finalize().
+    template<uint32_t N>
+        requires(N >= 16 and __globals::is_power_2(N))
+    class _uint_accumulator
+    {
+    public:
+        typedef uint64_t limb_type;
+        static constexpr uint8_t word_bits = 16;
+        static constexpr uint32_t words_num = N / word_bits;
+        // Range of limb capacities. Limbs stay below max_limb_capacity, so that carries of up
+        // to 2^48 can still be added during normalization; min_limb_capacity leaves room for
+        // the largest single increment, a product of operands narrower than 2^20 bits.
+        static constexpr limb_type max_limb_capacity = std::numeric_limits<limb_type>::max() - (limb_type(1) << 49);
+        static constexpr limb_type min_limb_capacity = limb_type(1) << 48;
+
+    private:
+        static constexpr limb_type word_max = 0xffff;
+
+        __instrumentation::counted_vector<limb_type> limbs;
+        limb_type limb_capacity;
+        // Upper bound on every limb
+        limb_type limb_bound;
+
+        void reserve(limb_type increment);
+
+    public:
+        // A lower capacity normalizes more often. Throws std::invalid_argument for a capacity
+        // outside [min_limb_capacity,max_limb_capacity].
+        explicit _uint_accumulator(limb_type capacity = max_limb_capacity);
+
+        // acc += x
+        template<uint32_t M, uint32_t M_significant>
+        void add(const _uint_view<M,M_significant>& x);
+
+        // acc += a*b
+        template<uint32_t M, uint32_t M_significant, uint32_t K, uint32_t K_significant>
+        void add_product(const _uint_view<M,M_significant>& a, const _uint_view<K,K_significant>& b);
+
+        // Propagates pending carries, leaving one word per limb.
+        void normalize();
+
+        // The accumulated value modulo 2^N. The accumulator stays usable.
+        _uint<N> finalize();
+
+        void reset();
+    };
+
+
+    template<uint32_t N>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _uint_accumulator<N>::_uint_accumulator(limb_type capacity) : limbs(words_num,0), limb_capacity(capacity), limb_bound(0)
+    {
+        if(capacity < min_limb_capacity or capacity > max_limb_capacity)
+            throw std::invalid_argument("accumulator capacity out of range");
+    }
+
+
+    template<uint32_t N>
+        requires(N >= 16 and __globals::is_power_2(N))
+    void _uint_accumulator<N>::reserve(limb_type increment)
+    {
+        if(limb_bound > limb_capacity - increment)
+            normalize();
+        limb_bound += increment;
+    }
+
+
+    template<uint32_t N>
+        requires(N >= 16 and __globals::is_power_2(N))
+    template<uint32_t M, uint32_t M_significant>
+    void _uint_accumulator<N>::add(const _uint_view<M,M_significant>& x)
+    {
+        constexpr uint32_t significant_ops = std::min(words_num,_uint_view<M,M_significant>::significant_words_num);
+        reserve(word_max);
+        for(uint32_t i(0); i < significant_ops; ++i)
+            limbs[i] += x.value[i];
+    }
+
+
+    template<uint32_t N>
+        requires(N >= 16 and __globals::is_power_2(N))
+    template<uint32_t M, uint32_t M_significant, uint32_t K, uint32_t K_significant>
+    void _uint_accumulator<N>::add_product(const _uint_view<M,M_significant>& a, const _uint_view<K,K_significant>& b)
+    {
+        constexpr uint32_t a_ops = std::min(words_num,_uint_view<M,M_significant>::significant_words_num);
+        constexpr uint32_t b_ops = std::min(words_num,_uint_view<K,K_significant>::significant_words_num);
+        // A limb receives at most min(a_ops,b_ops) partial products.
+        static_assert(std::min(a_ops,b_ops) < (1u << 16), "product increment exceeds the minimal limb capacity");
+        reserve(std::min(a_ops,b_ops) * word_max * word_max);
+        LRF_COUNT_PARTIAL_PRODUCTS(__kernels::mul_n_products(a_ops,b_ops,words_num));
+        if constexpr(N <= __globals::unrolled_kernels_bound)
+        {
+            limb_type *acc = limbs.data();
+            __globals::unroll<a_ops>([&](auto i)
+            {
+                limb_type a_v = a.value[i];
+                __globals::unroll<std::min(b_ops,words_num-i)>([&](auto j) { acc[i+j] += a_v*b.value[j]; });
+            });
+        }
+        else
+        {
+            for(uint32_t i(0); i < a_ops; ++i)
+            {
+                limb_type a_v = a.value[i];
+                limb_type *acc = limbs.data() + i;
+                uint32_t j_bound = std::min(b_ops,words_num-i);
+                for(uint32_t j(0); j < j_bound; ++j)
+                    acc[j] += a_v*b.value[j];
+            }
+        }
+    }
+
+
+    template<uint32_t N>
+        requires(N >= 16 and __globals::is_power_2(N))
+    void _uint_accumulator<N>::normalize()
+    {
+        limb_type carry = 0;
+        for(uint32_t i(0); i < words_num; ++i)
+        {
+            limb_type v = limbs[i] + carry;
+            limbs[i] = v & word_max;
+            carry = v >> word_bits;
+        }
+        limb_bound = word_max;
+    }
+
+
+    template<uint32_t N>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _uint<N> _uint_accumulator<N>::finalize()
+    {
+        normalize();
+        _uint<N> res;
+        std::copy(limbs.begin(),limbs.end(),res.value);
+        return res;
+    }
+
+
+    template<uint32_t N>
+        requires(N >= 16 and __globals::is_power_2(N))
+    void _uint_accumulator<N>::reset()
+    {
+        std::fill(limbs.begin(),limbs.end(),0);
+        limb_bound = 0;
+    }
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef LRF_BATCH_HPP
+#define LRF_BATCH_HPP
+
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "exponentiation.hpp"
+#include "thread_pool.hpp"
+
+namespace lrf
+{
+    // Element-wise operations over many independent operands, spread over a _thread_pool.
+    // Operands are spans of _uint or _uint_view of any width; results are written into the
+    // existing storage of out, truncated to its significant width. Kernels work on raw limbs in
+    // per-thread scratch arenas, so a batch does not allocate once the arenas have grown to size.
+
+    namespace __batch
+    {
+        // Scratch arena of the calling thread. Grows monotonically and lives as long as the thread.
+        inline uint16_t *scratch_arena(std::size_t words)
+        {
+            thread_local __instrumentation::counted_vector<uint16_t> arena;
+            if(arena.size() < words)
+                arena.resize(words);
+            return arena.data();
+        }
+
+        // Enough elements per grain to amortize the fetch_add, few enough to keep all threads busy.
+        inline std::size_t grain_size(std::size_t n, const _thread_pool& pool)
+        {
+            return std::max<std::size_t>(1,n / (pool.size()*16));
+        }
+
+        template<typename A, typename B, typename R>
+        void check_sizes(std::span<A> a, std::span<B> b, std::span<R> out)
+        {
+            if(a.size() != b.size() or a.size() != out.size())
+                throw std::invalid_argument("batch operands differ in size");
+        }
+
+        // res[0..R) = x[0..X) zero extended or truncated to R words
+        template<uint32_t X, uint32_t R>
+        void resize_copy(uint16_t *res, const uint16_t *x)
+        {
+            constexpr uint32_t copied = std::min(X,R);
+            std::copy(x,x+copied,res);
+            std::fill(res+copied,res+R,0);
+        }
+    }
+
+
+    // out[i] = a[i]*b[i] modulo 2^(significant bits of out[i]), the words above stay zero
+    template<_uint_like A, _uint_like B, _uint_like R>
+    void multiply_batch(std::span<const A> a, std::span<const B> b, std::span<R> out, _thread_pool& pool = _thread_pool::global())
+    {
+        constexpr uint32_t a_words = A::significant_words_num;
+        constexpr uint32_t b_words = B::significant_words_num;
+        constexpr uint32_t product_words = std::min(a_words+b_words,R::significant_words_num);
+        __batch::check_sizes(a,b,out);
+        pool.parallel_for(a.size(),[&](std::size_t begin, std::size_t end)
+        {
+            uint16_t *product = __batch::scratch_arena(product_words);
+            for(std::size_t i(begin); i < end; ++i)
+            {
+                if constexpr(a_words*16 <= __globals::unrolled_kernels_bound and b_words*16 <= __globals::unrolled_kernels_bound)
+                    __kernels::mul_n<a_words,b_words,product_words>(product,a[i].value,b[i].value);
+                else
+                    __kernels::mul_blocked(product,a[i].value,a_words,b[i].value,b_words,product_words);
+                __batch::resize_copy<product_words,R::words_num>(out[i].value,product);
+            }
+        },__batch::grain_size(a.size(),pool));
+    }
+
+
+    // out[i] = a[i]+b[i] modulo 2^(significant bits of out[i]), the words above stay zero
+    template<_uint_like A, _uint_like B, _uint_like R>
+    void add_batch(std::span<const A> a, std::span<const B> b, std::span<R> out, _thread_pool& pool = _thread_pool::global())
+    {
+        constexpr uint32_t r_words = R::significant_words_num;
+        constexpr uint32_t b_words = std::min(B::significant_words_num,r_words);
+        __batch::check_sizes(a,b,out);
+        pool.parallel_for(a.size(),[&](std::size_t begin, std::size_t end)
+        {
+            uint16_t *sum = __batch::scratch_arena(r_words);
+            for(std::size_t i(begin); i < end; ++i)
+            {
+                __batch::resize_copy<A::significant_words_num,r_words>(sum,a[i].value);
+                __kernels::add_inplace(sum,r_words,b[i].value,b_words);
+                __batch::resize_copy<r_words,R::words_num>(out[i].value,sum);
+            }
+        },__batch::grain_size(a.size(),pool));
+    }
+
+
+    // out[i] = a[i]-b[i] modulo 2^(significant bits of out[i]), the words above stay zero
+    template<_uint_like A, _uint_like B, _uint_like R>
+    void subtract_batch(std::span<const A> a, std::span<const B> b, std::span<R> out, _thread_pool& pool = _thread_pool::global())
+    {
+        constexpr uint32_t r_words = R::significant_words_num;
+        constexpr uint32_t b_words = std::min(B::significant_words_num,r_words);
+        __batch::check_sizes(a,b,out);
+        pool.parallel_for(a.size(),[&](std::size_t begin, std::size_t end)
+        {
+            uint16_t *diff = __batch::scratch_arena(r_words);
+            for(std::size_t i(begin); i < end; ++i)
+            {
+                __batch::resize_copy<A::significant_words_num,r_words>(diff,a[i].value);
+                __kernels::sub_inplace(diff,r_words,b[i].value,b_words);
+                __batch::resize_copy<r_words,R::words_num>(out[i].value,diff);
+            }
+        },__batch::grain_size(a.size(),pool));
+    }
+
+
+    // out[i] = base[i]^exp[i] mod modulus, one modulus shared by the whole batch.
+    // Throws std::domain_error for a zero modulus.
+    template<_uint_like A, _uint_like E, uint32_t K, uint32_t K_significant, _uint_like R>
+    void modexp_batch(std::span<const A> base, std::span<const E> exp, const _uint_view<K,K_significant>& modulus, std::span<R> out,
+                      _thread_pool& pool = _thread_pool::global())
+    {
+        typedef _mod_context<K,K_significant> context_type;
+        constexpr uint32_t words_num = context_type::words_num;
+        constexpr uint32_t base_words = A::significant_words_num;
+        constexpr uint32_t exp_words = E::significant_words_num;
+        constexpr uint32_t scratch_words = context_type::scratch_words_num(base_words);
+        constexpr uint32_t arena_words = scratch_words + 2*words_num + context_type::table_words_num(exp_words*16);
+        __batch::check_sizes(base,exp,out);
+        const context_type context(modulus);
+        pool.parallel_for(base.size(),[&](std::size_t begin, std::size_t end)
+        {
+            uint16_t *scratch = __batch::scratch_arena(arena_words);
+            uint16_t *base_repr = scratch + scratch_words;
+            uint16_t *res = base_repr + words_num;
+            uint16_t *table = res + words_num;
+            for(std::size_t i(begin); i < end; ++i)
+            {
+                context.to_repr(base_repr,base[i].value,base_words,scratch);
+                context.pow(res,base_repr,exp[i].value,exp_words,table,scratch);
+                context.from_repr(res,res,scratch);
+                __batch::resize_copy<words_num,R::words_num>(out[i].value,res);
+            }
+        },__batch::grain_size(base.size(),pool));
+    }
+}
+
+#endif
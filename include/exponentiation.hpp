@@ -0,0 +1,452 @@
+#ifndef LRF_EXPONENTIATION_HPP
+#define LRF_EXPONENTIATION_HPP
+
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "mod_uint.hpp"
+
+namespace lrf
+{
+    // Arithmetic modulo m for a modulus known only at run time. Odd moduli use Montgomery
+    // multiplication and residues are kept in Montgomery form; even moduli fall back to long
+    // division. Low level members work on words_num word residues and take caller provided
+    // scratch, so that contexts can be shared between threads and used without allocating.
+    template<uint32_t N, uint32_t N_significant=N>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    class _mod_context
+    {
+    public:
+        typedef uint16_t word_type;
+        static constexpr uint8_t word_bits = sizeof(word_type) * 8;
+        static constexpr uint32_t words_num = _uint_view<N,N_significant>::significant_words_num;
+
+    private:
+        _uint<N,N_significant> modulus;
+        // Montgomery form of 1 and R^2 mod m, R = 2^(16 words_num)
+        _uint<N,N_significant> one_repr;
+        _uint<N,N_significant> r2;
+        uint16_t p_inv;
+        bool montgomery;
+
+    public:
+        explicit _mod_context(const _uint_view<N,N_significant>& m);
+
+        bool is_montgomery() const { return montgomery; }
+
+        const uint16_t *modulus_words() const { return modulus.value; }
+
+        // 1 in the internal representation
+        const uint16_t *one() const { return one_repr.value; }
+
+        // Scratch words needed by to_repr() for an operand of x_words words, and by all other members.
+        static constexpr uint32_t scratch_words_num(uint32_t x_words = 0) { return std::max(x_words+words_num+1,5*words_num+1); }
+
+        // Window width used by pow() and the number of table words it needs.
+        static constexpr uint8_t window_bits(uint32_t exp_bits) { return exp_bits > 1536 ? 6 : exp_bits > 384 ? 5 : exp_bits > 96 ? 4 : exp_bits > 24 ? 3 : 2; }
+        static constexpr uint32_t table_words_num(uint32_t exp_bits) { return (1u << window_bits(exp_bits))*words_num; }
+
+        // Bucket width for multi_modexp() over k exponents of exp_bits bits, or 0 if Straus' windows
+        // take fewer multiplications. Straus pays 2^w table entries and one multiplication per window
+        // for every base; Pippenger pays one multiplication per window for every base and 2^(c+1)
+        // per window to combine the buckets.
+        static constexpr uint8_t bucket_bits(std::size_t k, uint32_t exp_bits)
+        {
+            uint8_t window = window_bits(exp_bits);
+            uint64_t best_cost = k*((1u << window) + (exp_bits+window-1)/window);
+            uint8_t best_bits = 0;
+            for(uint8_t c(2); c <= 16; ++c)
+            {
+                uint64_t cost = (exp_bits+c-1)/c * (k + (2u << c));
+                if(cost < best_cost)
+                {
+                    best_cost = cost;
+                    best_bits = c;
+                }
+            }
+            return best_bits;
+        }
+
+        // res = x mod m in the internal representation
+        void to_repr(uint16_t *res, const uint16_t *x, uint32_t x_words, uint16_t *scratch) const;
+
+        void from_repr(uint16_t *res, const uint16_t *x, uint16_t *scratch) const;
+
+        // res = a*b mod m. res may alias the operands.
+        void mul(uint16_t *res, const uint16_t *a, const uint16_t *b, uint16_t *scratch) const;
+
+        // res = a^2 mod m, summing every cross product once. res may alias a.
+        void sqr(uint16_t *res, const uint16_t *a, uint16_t *scratch) const;
+
+        // res = base^exp mod m, fixed window exponentiation. Runs in time dependent on exp.
+        // res may alias base.
+        void pow(uint16_t *res, const uint16_t *base, const uint16_t *exp, uint32_t exp_words, uint16_t *table, uint16_t *scratch) const;
+
+        template<uint32_t M, uint32_t M_significant, uint32_t K, uint32_t K_significant>
+        _uint<N,N_significant> pow(const _uint_view<M,M_significant>& base, const _uint_view<K,K_significant>& exp) const;
+    };
+
+
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    _mod_context<N,N_significant>::_mod_context(const _uint_view<N,N_significant>& m) : modulus(0), one_repr(0), r2(0), p_inv(0)
+    {
+        if(__kernels::significant_size(m.value,words_num) == 0)
+            throw std::domain_error("zero modulus");
+        std::copy(m.value,m.value+words_num,modulus.value);
+        montgomery = modulus.value[0] & 1;
+        __instrumentation::counted_vector<uint16_t> power(2*words_num+1,0);
+        if(montgomery)
+        {
+            uint32_t inv = modulus.value[0];
+            for(uint8_t i(0); i < 4; ++i)
+                inv *= 2 - modulus.value[0]*inv;
+            p_inv = -inv;
+            power[words_num] = 1;
+            __kernels::divmod(nullptr,one_repr.value,power.data(),words_num+1,modulus.value,words_num);
+            power[words_num] = 0;
+            power[2*words_num] = 1;
+            __kernels::divmod(nullptr,r2.value,power.data(),2*words_num+1,modulus.value,words_num);
+        }
+        else
+        {
+            power[0] = 1;
+            __kernels::divmod(nullptr,one_repr.value,power.data(),1,modulus.value,words_num);
+        }
+    }
+
+
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    void _mod_context<N,N_significant>::to_repr(uint16_t *res, const uint16_t *x, uint32_t x_words, uint16_t *scratch) const
+    {
+        if(__kernels::compare(x,x_words,modulus.value,words_num) < 0)
+        {
+            uint32_t x_significant = __kernels::significant_size(x,x_words);
+            std::copy(x,x+x_significant,res);
+            std::fill(res+x_significant,res+words_num,0);
+        }
+        else
+            __kernels::divmod(nullptr,res,x,x_words,modulus.value,words_num,scratch);
+        if(montgomery)
+            __kernels::mont_mul<words_num>(res,res,r2.value,modulus.value,p_inv);
+    }
+
+
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    void _mod_context<N,N_significant>::from_repr(uint16_t *res, const uint16_t *x, uint16_t *scratch) const
+    {
+        if(montgomery)
+        {
+            std::fill(scratch,scratch+words_num,0);
+            scratch[0] = 1;
+            __kernels::mont_mul<words_num>(res,x,scratch,modulus.value,p_inv);
+        }
+        else
+            std::copy(x,x+words_num,res);
+    }
+
+
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    void _mod_context<N,N_significant>::mul(uint16_t *res, const uint16_t *a, const uint16_t *b, uint16_t *scratch) const
+    {
+        if(montgomery)
+        {
+            __kernels::mont_mul<words_num>(res,a,b,modulus.value,p_inv);
+            return;
+        }
+        __kernels::mul(scratch,a,words_num,b,words_num);
+        __kernels::divmod(nullptr,res,scratch,2*words_num,modulus.value,words_num,scratch+2*words_num);
+    }
+
+
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    void _mod_context<N,N_significant>::sqr(uint16_t *res, const uint16_t *a, uint16_t *scratch) const
+    {
+        if constexpr(N_significant <= __globals::unrolled_kernels_bound)
+            __kernels::sqr_n<words_num>(scratch,a);
+        else
+            __kernels::sqr(scratch,a,words_num);
+        if(montgomery)
+            __kernels::mont_reduce<words_num>(res,scratch,modulus.value,p_inv);
+        else
+            __kernels::divmod(nullptr,res,scratch,2*words_num,modulus.value,words_num,scratch+2*words_num);
+    }
+
+
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    void _mod_context<N,N_significant>::pow(uint16_t *res, const uint16_t *base, const uint16_t *exp, uint32_t exp_words, uint16_t *table, uint16_t *scratch) const
+    {
+        uint32_t exp_bits = __kernels::bit_length(exp,exp_words);
+        if(exp_bits == 0)
+        {
+            std::copy(one_repr.value,one_repr.value+words_num,res);
+            return;
+        }
+        uint8_t window = window_bits(exp_bits);
+        uint32_t table_size = 1u << window;
+        std::copy(one_repr.value,one_repr.value+words_num,table);
+        std::copy(base,base+words_num,table+words_num);
+        for(uint32_t i(2); i < table_size; ++i)
+            mul(table+i*words_num,table+(i-1)*words_num,base,scratch);
+
+        uint32_t windows_num = (exp_bits+window-1)/window;
+        uint32_t digit = __kernels::extract_bits(exp,exp_words,(windows_num-1)*window) & (table_size-1);
+        std::copy(table+digit*words_num,table+(digit+1)*words_num,res);
+        for(uint32_t i(windows_num-1); i-- > 0;)
+        {
+            for(uint8_t j(0); j < window; ++j)
+                sqr(res,res,scratch);
+            digit = __kernels::extract_bits(exp,exp_words,i*window) & (table_size-1);
+            if(digit)
+                mul(res,res,table+digit*words_num,scratch);
+        }
+    }
+
+
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    template<uint32_t M, uint32_t M_significant, uint32_t K, uint32_t K_significant>
+    _uint<N,N_significant> _mod_context<N,N_significant>::pow(const _uint_view<M,M_significant>& base, const _uint_view<K,K_significant>& exp) const
+    {
+        constexpr uint32_t base_words = _uint_view<M,M_significant>::significant_words_num;
+        constexpr uint32_t exp_words = _uint_view<K,K_significant>::significant_words_num;
+        __instrumentation::counted_vector<uint16_t> scratch(scratch_words_num(base_words)+table_words_num(exp_words*word_bits)+words_num);
+        uint16_t *base_repr = scratch.data()+scratch_words_num(base_words);
+        uint16_t *table = base_repr+words_num;
+        _uint<N,N_significant> res(0);
+        to_repr(base_repr,base.value,base_words,scratch.data());
+        pow(res.value,base_repr,exp.value,exp_words,table,scratch.data());
+        from_repr(res.value,res.value,scratch.data());
+        return res;
+    }
+
+
+    // base^exp mod modulus. Throws std::domain_error for a zero modulus.
+    template<uint32_t N, uint32_t N_significant, uint32_t M, uint32_t M_significant, uint32_t K, uint32_t K_significant>
+    _uint<K,K_significant> modexp(const _uint_view<N,N_significant>& base, const _uint_view<M,M_significant>& exp, const _uint_view<K,K_significant>& modulus)
+    {
+        return _mod_context<K,K_significant>(modulus).pow(base,exp);
+    }
+
+
+    // Exponentiation of one base modulo one modulus with the Lim-Lee comb method. An exponent of
+    // up to exp_bits bits is cut into `teeth` blocks of block_bits bits and every block into
+    // `sub_blocks` sub-blocks of sub_block_bits bits. The table holds, for each sub-block j and
+    // each teeth pattern u, the product of base^(2^(i*block_bits + j*sub_block_bits)) over the set
+    // bits i of u. A power then takes sub_block_bits-1 squarings and up to
+    // sub_blocks*sub_block_bits multiplications. The table is one contiguous array of
+    // sub_blocks*2^teeth residues.
+    template<uint32_t N, uint32_t N_significant=N>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    class _fixed_base_modexp
+    {
+    public:
+        typedef uint16_t word_type;
+        static constexpr uint8_t word_bits = sizeof(word_type) * 8;
+        static constexpr uint32_t words_num = _mod_context<N,N_significant>::words_num;
+        static constexpr uint8_t sub_blocks = 2;
+
+    private:
+        _mod_context<N,N_significant> context;
+        uint32_t exp_bits;
+        uint8_t teeth;
+        uint32_t block_bits;
+        uint32_t sub_block_bits;
+        __instrumentation::counted_vector<uint16_t> table;
+
+        const uint16_t *entry(uint32_t j, uint32_t u) const { return table.data() + ((j << teeth) | u)*words_num; }
+        uint16_t *entry(uint32_t j, uint32_t u) { return table.data() + ((j << teeth) | u)*words_num; }
+
+    public:
+        static constexpr uint8_t default_teeth(uint32_t exp_bits) { return exp_bits >= 1024 ? 7 : exp_bits >= 256 ? 6 : exp_bits >= 64 ? 5 : 4; }
+
+        // Throws std::domain_error for a zero modulus.
+        template<uint32_t M, uint32_t M_significant>
+        _fixed_base_modexp(const _uint_view<M,M_significant>& base, const _uint_view<N,N_significant>& modulus, uint32_t exp_bits);
+
+        uint32_t max_exp_bits() const { return exp_bits; }
+
+        // res = base^exp mod m. Throws std::invalid_argument if exp is wider than max_exp_bits().
+        template<uint32_t K, uint32_t K_significant>
+        _uint<N,N_significant> pow(const _uint_view<K,K_significant>& exp) const;
+    };
+
+
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    template<uint32_t M, uint32_t M_significant>
+    _fixed_base_modexp<N,N_significant>::_fixed_base_modexp(const _uint_view<M,M_significant>& base, const _uint_view<N,N_significant>& modulus, uint32_t exp_bits)
+        : context(modulus), exp_bits(std::max(exp_bits,1u)), teeth(default_teeth(exp_bits))
+    {
+        block_bits = (this->exp_bits+teeth-1)/teeth;
+        sub_block_bits = (block_bits+sub_blocks-1)/sub_blocks;
+        table.resize((sub_blocks << teeth)*words_num);
+        __instrumentation::counted_vector<uint16_t> scratch(context.scratch_words_num(_uint_view<M,M_significant>::significant_words_num));
+
+        // entry(j,2^i) = base^(2^(i*block_bits + j*sub_block_bits)), by repeated squaring
+        __instrumentation::counted_vector<uint16_t> power(words_num);
+        context.to_repr(power.data(),base.value,_uint_view<M,M_significant>::significant_words_num,scratch.data());
+        for(uint32_t i(0); i < teeth; ++i)
+            for(uint32_t j(0); j < sub_blocks; ++j)
+            {
+                std::copy(power.begin(),power.end(),entry(j,1u << i));
+                uint32_t squarings = j+1 < sub_blocks ? sub_block_bits : block_bits - (sub_blocks-1)*sub_block_bits;
+                for(uint32_t k(0); k < squarings; ++k)
+                    context.sqr(power.data(),power.data(),scratch.data());
+            }
+        // Every other pattern is the previous one with its top bit multiplied in
+        for(uint32_t j(0); j < sub_blocks; ++j)
+        {
+            std::copy(context.one(),context.one()+words_num,entry(j,0));
+            for(uint32_t u(3); u < (1u << teeth); ++u)
+            {
+                uint32_t top = std::bit_floor(u);
+                if(u != top)
+                    context.mul(entry(j,u),entry(j,u^top),entry(j,top),scratch.data());
+            }
+        }
+    }
+
+
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    template<uint32_t K, uint32_t K_significant>
+    _uint<N,N_significant> _fixed_base_modexp<N,N_significant>::pow(const _uint_view<K,K_significant>& exp) const
+    {
+        constexpr uint32_t exp_words = _uint_view<K,K_significant>::significant_words_num;
+        if(__kernels::bit_length(exp.value,exp_words) > exp_bits)
+            throw std::invalid_argument("exponent wider than the precomputed table");
+        auto bit = [&](uint32_t pos) -> uint32_t { return pos/word_bits < exp_words ? (exp.value[pos/word_bits] >> pos%word_bits) & 1 : 0; };
+
+        __instrumentation::counted_vector<uint16_t> scratch(context.scratch_words_num());
+        _uint<N,N_significant> res(0);
+        std::copy(context.one(),context.one()+words_num,res.value);
+        for(uint32_t k(sub_block_bits); k-- > 0;)
+        {
+            if(k+1 < sub_block_bits)
+                context.sqr(res.value,res.value,scratch.data());
+            for(uint32_t j(sub_blocks); j-- > 0;)
+            {
+                uint32_t offset = j*sub_block_bits + k;
+                if(offset >= block_bits)
+                    continue;
+                uint32_t u = 0;
+                for(uint32_t i(0); i < teeth; ++i)
+                    u |= bit(i*block_bits + offset) << i;
+                if(u)
+                    context.mul(res.value,res.value,entry(j,u),scratch.data());
+            }
+        }
+        context.from_repr(res.value,res.value,scratch.data());
+        return res;
+    }
+
+
+    // Product of bases[i]^exps[i] mod modulus. Both methods share the squarings between all terms.
+    // Straus: every base gets its own window table and each window multiplies in one entry per base.
+    // Pippenger: each window sorts the bases into one bucket per digit value and combines the
+    // buckets with two running products, so a base costs one multiplication per window and the
+    // tables do not grow with the number of bases.
+    // Throws std::domain_error for a zero modulus and std::invalid_argument if the spans differ in size.
+    template<_uint_like B, _uint_like E, uint32_t K, uint32_t K_significant>
+    _uint<K,K_significant> multi_modexp(std::span<const B> bases, std::span<const E> exps, const _uint_view<K,K_significant>& modulus)
+    {
+        typedef _mod_context<K,K_significant> context_type;
+        constexpr uint32_t words_num = context_type::words_num;
+        constexpr uint32_t base_words = B::significant_words_num;
+        constexpr uint32_t exp_words = E::significant_words_num;
+        if(bases.size() != exps.size())
+            throw std::invalid_argument("multi_modexp operands differ in size");
+        const context_type context(modulus);
+        const std::size_t k = bases.size();
+        uint32_t exp_bits = 0;
+        for(const E& exp : exps)
+            exp_bits = std::max(exp_bits,__kernels::bit_length(exp.value,exp_words));
+
+        uint8_t bucket_bits = context_type::bucket_bits(k,exp_bits);
+        bool straus = bucket_bits == 0;
+        uint8_t window = straus ? context_type::window_bits(exp_bits) : bucket_bits;
+        uint32_t table_size = 1u << window;
+        // Straus: k tables of table_size entries. Pippenger: k bases, table_size buckets, two running products.
+        std::size_t entries_num = straus ? k*table_size : k+table_size+2;
+        __instrumentation::counted_vector<uint16_t> scratch(context_type::scratch_words_num(base_words)+entries_num*words_num);
+        uint16_t *entries = scratch.data()+context_type::scratch_words_num(base_words);
+        for(std::size_t i(0); i < k; ++i)
+        {
+            uint16_t *base_repr = straus ? entries+(i*table_size+1)*words_num : entries+i*words_num;
+            context.to_repr(base_repr,bases[i].value,base_words,scratch.data());
+            if(straus)
+                for(uint32_t d(2); d < table_size; ++d)
+                    context.mul(base_repr+(d-1)*words_num,base_repr+(d-2)*words_num,base_repr,scratch.data());
+        }
+        uint16_t *buckets = entries+k*words_num;
+        uint16_t *suffix = buckets+table_size*words_num;
+        uint16_t *total = suffix+words_num;
+        __instrumentation::counted_vector<uint8_t> bucket_used(straus ? 0 : table_size);
+
+        _uint<K,K_significant> res(0);
+        std::copy(context.one(),context.one()+words_num,res.value);
+        uint32_t windows_num = (exp_bits+window-1)/window;
+        for(uint32_t w(windows_num); w-- > 0;)
+        {
+            if(w+1 < windows_num)
+                for(uint8_t j(0); j < window; ++j)
+                    context.sqr(res.value,res.value,scratch.data());
+            if(straus)
+            {
+                for(std::size_t i(0); i < k; ++i)
+                {
+                    uint32_t digit = __kernels::extract_bits(exps[i].value,exp_words,w*window) & (table_size-1);
+                    if(digit)
+                        context.mul(res.value,res.value,entries+(i*table_size+digit)*words_num,scratch.data());
+                }
+                continue;
+            }
+
+            std::fill(bucket_used.begin(),bucket_used.end(),0);
+            for(std::size_t i(0); i < k; ++i)
+            {
+                uint32_t digit = __kernels::extract_bits(exps[i].value,exp_words,w*window) & (table_size-1);
+                if(!digit)
+                    continue;
+                uint16_t *bucket = buckets+digit*words_num;
+                if(bucket_used[digit])
+                    context.mul(bucket,bucket,entries+i*words_num,scratch.data());
+                else
+                    std::copy(entries+i*words_num,entries+(i+1)*words_num,bucket);
+                bucket_used[digit] = 1;
+            }
+            // total = prod bucket[d]^d, as the product over d of suffix[d] = prod of bucket[d..]
+            bool suffix_used = false, total_used = false;
+            for(uint32_t d(table_size); d-- > 1;)
+            {
+                if(bucket_used[d])
+                {
+                    if(suffix_used)
+                        context.mul(suffix,suffix,buckets+d*words_num,scratch.data());
+                    else
+                        std::copy(buckets+d*words_num,buckets+(d+1)*words_num,suffix);
+                    suffix_used = true;
+                }
+                if(!suffix_used)
+                    continue;
+                if(total_used)
+                    context.mul(total,total,suffix,scratch.data());
+                else
+                    std::copy(suffix,suffix+words_num,total);
+                total_used = true;
+            }
+            if(total_used)
+                context.mul(res.value,res.value,total,scratch.data());
+        }
+        context.from_repr(res.value,res.value,scratch.data());
+        return res;
+    }
+}
+
+#endif
@@ -0,0 +1,416 @@
+#ifndef LRF_GCD_HPP
+#define LRF_GCD_HPP
+
+#include <cstdlib>
+#include <optional>
+#include <vector>
+#include "uint.hpp"
+
+namespace lrf
+{
+    namespace __kernels
+    {
+        // Leading bits of u used to simulate Euclid in single precision. Keeps the cofactors
+        // below 2^32, so a cofactor times a word never leaves int64_t.
+        constexpr uint32_t lehmer_digit_bits = 32;
+
+        // Number of divsteps batched into one transition matrix by the constant time inverse.
+        constexpr uint32_t divsteps_batch = 30;
+
+
+        // (a,b) = (a*u + b*v, a*w + b*z) for signed single precision cofactors.
+        // Both results must be non-negative and fit in n words.
+        inline void linear_transform(uint16_t *a, uint16_t *b, uint32_t n, int64_t u, int64_t v, int64_t w, int64_t z)
+        {
+            int64_t carry_a = 0, carry_b = 0;
+            for(uint32_t i(0); i < n; ++i)
+            {
+                int64_t a_i = a[i], b_i = b[i];
+                carry_a += u*a_i + v*b_i;
+                carry_b += w*a_i + z*b_i;
+                a[i] = carry_a & word_mask;
+                b[i] = carry_b & word_mask;
+                carry_a >>= word_bits;
+                carry_b >>= word_bits;
+            }
+        }
+
+
+        // Same as linear_transform, for cofactor magnitudes, which only ever grow.
+        inline void linear_transform_abs(uint16_t *a, uint16_t *b, uint32_t n, uint64_t u, uint64_t v, uint64_t w, uint64_t z)
+        {
+            uint64_t carry_a = 0, carry_b = 0;
+            for(uint32_t i(0); i < n; ++i)
+            {
+                uint64_t a_i = a[i], b_i = b[i];
+                carry_a += u*a_i + v*b_i;
+                carry_b += w*a_i + z*b_i;
+                a[i] = carry_a & word_mask;
+                b[i] = carry_b & word_mask;
+                carry_a >>= word_bits;
+                carry_b >>= word_bits;
+            }
+        }
+
+
+        // Lehmer's gcd (Knuth, TAOCP vol. 2, 4.5.2, algorithm L) on n word operands.
+        // On return u holds gcd(u,v) and v is zero. If su and sv (sn words each) are given, they
+        // go through the same Euclid steps as u and v in magnitude form: the cofactor paired with
+        // the i-th remainder has sign (-1)^i relative to the one it started with.
+        // Returns the parity of the index i of the remainder left in u.
+        inline bool lehmer_gcd(uint16_t *u, uint16_t *v, uint32_t n, uint16_t *su, uint16_t *sv, uint32_t sn)
+        {
+            bool odd = false;
+            if(compare(u,n,v,n) < 0)
+            {
+                std::swap_ranges(u,u+n,v);
+                if(su)
+                    std::swap_ranges(su,su+sn,sv);
+                odd = true;
+            }
+
+            __instrumentation::counted_vector<uint16_t> q, r, t;
+            while(true)
+            {
+                uint32_t vn = significant_size(v,n);
+                if(vn == 0)
+                    break;
+                uint32_t un = significant_size(u,n);
+                uint32_t u_bits = bit_length(u,un);
+                uint32_t shift = u_bits > lehmer_digit_bits ? u_bits - lehmer_digit_bits : 0;
+                int64_t x = extract_bits(u,un,shift);
+                int64_t y = extract_bits(v,vn,shift);
+                int64_t a = 1, b = 0, c = 0, d = 1;
+                bool steps_odd = false;
+                while(y + c != 0 and y + d != 0)
+                {
+                    int64_t quot = (x + a) / (y + c);
+                    if(quot != (x + b) / (y + d))
+                        break;
+                    int64_t tmp = a - quot*c; a = c; c = tmp;
+                    tmp = b - quot*d; b = d; d = tmp;
+                    tmp = x - quot*y; x = y; y = tmp;
+                    steps_odd = !steps_odd;
+                }
+
+                if(b == 0)
+                {
+                    // The leading bits did not pin down a single quotient, take a full division step.
+                    q.assign(un,0);
+                    r.assign(vn,0);
+                    divmod(q.data(),r.data(),u,un,v,vn);
+                    std::copy(v,v+n,u);
+                    std::copy(r.begin(),r.end(),v);
+                    std::fill(v+vn,v+n,0);
+                    if(su)
+                    {
+                        uint32_t qn = significant_size(q.data(),un);
+                        uint32_t svn = significant_size(sv,sn);
+                        t.assign(std::max(qn+svn,sn),0);
+                        mul(t.data(),q.data(),qn,sv,svn);
+                        add_inplace(t.data(),t.size(),su,sn);
+                        std::copy(sv,sv+sn,su);
+                        std::copy(t.begin(),t.begin()+sn,sv);
+                    }
+                    odd = !odd;
+                }
+                else
+                {
+                    linear_transform(u,v,un,a,b,c,d);
+                    if(su)
+                        linear_transform_abs(su,sv,sn,std::abs(a),std::abs(b),std::abs(c),std::abs(d));
+                    odd ^= steps_odd;
+                }
+            }
+            return odd;
+        }
+
+
+        struct divsteps_matrix
+        {
+            int64_t u, v, q, r;
+        };
+
+
+        // Runs divsteps_batch Bernstein-Yang divsteps on the low bits of f and g and returns the
+        // updated delta. The transition matrix satisfies 2^divsteps_batch*(f',g') = (u*f+v*g, q*f+r*g).
+        // Branch-free: the running time does not depend on the operands.
+        inline int64_t divsteps(int64_t delta, uint64_t f, uint64_t g, divsteps_matrix& t)
+        {
+            int64_t u = 1, v = 0, q = 0, r = 1;
+            for(uint32_t i(0); i < divsteps_batch; ++i)
+            {
+                int64_t g_odd = -(int64_t)(g & 1);
+                int64_t swap = ((-delta) >> 63) & g_odd;
+                uint64_t x = (f ^ (uint64_t)swap) - (uint64_t)swap;
+                int64_t y = (u ^ swap) - swap;
+                int64_t z = (v ^ swap) - swap;
+                g += x & (uint64_t)g_odd;
+                q += y & g_odd;
+                r += z & g_odd;
+                f += g & (uint64_t)swap;
+                u += q & swap;
+                v += r & swap;
+                delta = ((delta ^ swap) - swap) + 1;
+                g >>= 1;
+                u *= 2;
+                v *= 2;
+            }
+            t = {u,v,q,r};
+            return delta;
+        }
+
+
+        // (f,g) = (u*f + v*g, q*f + r*g) / 2^divsteps_batch on L word two's complement values.
+        template<uint32_t L>
+        void divsteps_update_fg(uint16_t *f, uint16_t *g, const divsteps_matrix& t)
+        {
+            uint16_t f_wide[L+2], g_wide[L+2];
+            int64_t carry_f = 0, carry_g = 0;
+            for(uint32_t i(0); i < L; ++i)
+            {
+                int64_t f_i = i == L-1 ? (int16_t)f[i] : f[i];
+                int64_t g_i = i == L-1 ? (int16_t)g[i] : g[i];
+                carry_f += t.u*f_i + t.v*g_i;
+                carry_g += t.q*f_i + t.r*g_i;
+                f_wide[i] = carry_f & word_mask;
+                g_wide[i] = carry_g & word_mask;
+                carry_f >>= word_bits;
+                carry_g >>= word_bits;
+            }
+            for(uint32_t i(L); i < L+2; ++i)
+            {
+                f_wide[i] = carry_f & word_mask;
+                g_wide[i] = carry_g & word_mask;
+                carry_f >>= word_bits;
+                carry_g >>= word_bits;
+            }
+            shift_right(f_wide,f_wide+1,L+1,divsteps_batch-word_bits);
+            shift_right(g_wide,g_wide+1,L+1,divsteps_batch-word_bits);
+            std::copy(f_wide,f_wide+L,f);
+            std::copy(g_wide,g_wide+L,g);
+        }
+
+
+        // a[0..n) += b[0..bn) & mask, ignoring the carry out.
+        inline void masked_add(uint16_t *a, uint32_t n, const uint16_t *b, uint32_t bn, uint16_t mask)
+        {
+            uint32_t r = 0;
+            for(uint32_t i(0); i < n; ++i)
+            {
+                uint32_t word_sum = (uint32_t)a[i] + (uint32_t)((i < bn ? b[i] : 0) & mask) + r;
+                a[i] = word_sum & word_mask;
+                r = word_sum >> word_bits;
+            }
+        }
+
+
+        // a[0..n) -= m[0..mn) if a >= m, without branching on a.
+        inline void masked_reduce(uint16_t *a, uint32_t n, const uint16_t *m, uint32_t mn)
+        {
+            uint32_t r = 0;
+            for(uint32_t i(0); i < n; ++i)
+                r = ((uint32_t)a[i] - (uint32_t)(i < mn ? m[i] : 0) - r) >> 31;
+            uint16_t mask = (uint16_t)r - 1;
+            r = 0;
+            for(uint32_t i(0); i < n; ++i)
+            {
+                uint32_t word_diff = (uint32_t)a[i] - (uint32_t)((i < mn ? m[i] : 0) & mask) - r;
+                a[i] = word_diff & word_mask;
+                r = word_diff >> 31;
+            }
+        }
+
+
+        // (d,e) = (u*d + v*e, q*d + r*e) / 2^divsteps_batch mod m, for d,e in [0,m)
+        // stored in L = W+1 words. minv is m^-1 mod 2^32.
+        template<uint32_t W, uint32_t L = W+1>
+        void divsteps_update_de(uint16_t *d, uint16_t *e, const uint16_t *m, uint32_t minv, const divsteps_matrix& t)
+        {
+            constexpr uint32_t batch_mask = (uint32_t(1) << divsteps_batch) - 1;
+            uint64_t d_low = d[0] | ((uint64_t)d[1] << word_bits);
+            uint64_t e_low = e[0] | ((uint64_t)e[1] << word_bits);
+            int64_t k_d = (uint32_t)(-((uint64_t)t.u*d_low + (uint64_t)t.v*e_low) * minv) & batch_mask;
+            int64_t k_e = (uint32_t)(-((uint64_t)t.q*d_low + (uint64_t)t.r*e_low) * minv) & batch_mask;
+
+            uint16_t d_wide[L+2], e_wide[L+2];
+            int64_t carry_d = 0, carry_e = 0;
+            for(uint32_t i(0); i < L+2; ++i)
+            {
+                int64_t d_i = i < L ? d[i] : 0;
+                int64_t e_i = i < L ? e[i] : 0;
+                int64_t m_i = i < W ? m[i] : 0;
+                carry_d += t.u*d_i + t.v*e_i + k_d*m_i;
+                carry_e += t.q*d_i + t.r*e_i + k_e*m_i;
+                d_wide[i] = carry_d & word_mask;
+                e_wide[i] = carry_e & word_mask;
+                carry_d >>= word_bits;
+                carry_e >>= word_bits;
+            }
+            shift_right(d_wide,d_wide+1,L+1,divsteps_batch-word_bits);
+            shift_right(e_wide,e_wide+1,L+1,divsteps_batch-word_bits);
+            std::copy(d_wide,d_wide+L,d);
+            std::copy(e_wide,e_wide+L,e);
+
+            // Both are in (-2m,3m) now.
+            for(uint16_t *x : {d,e})
+            {
+                masked_add(x,L,m,W,-(x[L-1] >> 15));
+                masked_add(x,L,m,W,-(x[L-1] >> 15));
+                masked_reduce(x,L,m,W);
+                masked_reduce(x,L,m,W);
+            }
+        }
+    }
+
+
+    template<uint32_t N, uint32_t N_significant>
+    struct _uint_xgcd_result
+    {
+        _uint<N,N_significant> gcd;
+        _uint<N,N_significant> x;
+        _uint<N,N_significant> y;
+        bool x_negative;
+        bool y_negative;
+    };
+
+
+    // Greatest common divisor, gcd(0,0) = 0.
+    template<uint32_t N, uint32_t N_significant>
+    _uint<N,N_significant> gcd(const _uint_view<N,N_significant>& a, const _uint_view<N,N_significant>& b)
+    {
+        constexpr uint32_t n = _uint_view<N,N_significant>::significant_words_num;
+        _uint<N,N_significant> u(0), v(0);
+        std::copy(a.value,a.value+n,u.value);
+        std::copy(b.value,b.value+n,v.value);
+        __kernels::lehmer_gcd(u.value,v.value,n,nullptr,nullptr,0);
+        return u;
+    }
+
+
+    // Extended gcd: gcd = a*x + b*y, x and y are returned as magnitudes with separate signs.
+    template<uint32_t N, uint32_t N_significant>
+    _uint_xgcd_result<N,N_significant> xgcd(const _uint_view<N,N_significant>& a, const _uint_view<N,N_significant>& b)
+    {
+        constexpr uint32_t n = _uint_view<N,N_significant>::significant_words_num;
+        _uint_xgcd_result<N,N_significant> res{0,0,0,false,false};
+        __instrumentation::counted_vector<uint16_t> v(b.value,b.value+n), su(n+1,0), sv(n+1,0);
+        std::copy(a.value,a.value+n,res.gcd.value);
+        su[0] = 1;
+        bool odd = __kernels::lehmer_gcd(res.gcd.value,v.data(),n,su.data(),sv.data(),n+1);
+        std::copy(su.begin(),su.begin()+n,res.x.value);
+        res.x_negative = odd and __kernels::significant_size(su.data(),n);
+
+        uint32_t bn = __kernels::significant_size(b.value,n);
+        if(bn == 0)
+            return res;
+        // y = (gcd - a*x) / b
+        __instrumentation::counted_vector<uint16_t> ax(2*n+1,0), y(2*n+1);
+        __kernels::mul(ax.data(),a.value,n,su.data(),n);
+        if(res.x_negative)
+            __kernels::add_inplace(ax.data(),2*n+1,res.gcd.value,n);
+        else if(__kernels::compare(ax.data(),2*n+1,res.gcd.value,n) >= 0)
+        {
+            __kernels::sub_inplace(ax.data(),2*n+1,res.gcd.value,n);
+            res.y_negative = true;
+        }
+        else
+        {
+            __instrumentation::counted_vector<uint16_t> g(res.gcd.value,res.gcd.value+n);
+            __kernels::sub_inplace(g.data(),n,ax.data(),n);
+            std::fill(ax.begin(),ax.end(),0);
+            std::copy(g.begin(),g.end(),ax.begin());
+        }
+        __kernels::divmod(y.data(),nullptr,ax.data(),2*n+1,b.value,bn);
+        std::copy(y.begin(),y.begin()+n,res.y.value);
+        res.y_negative = res.y_negative and __kernels::significant_size(y.data(),n);
+        return res;
+    }
+
+
+    // Inverse of a modulo m via Lehmer's extended gcd, or nothing if gcd(a,m) != 1.
+    // Running time depends on the operands, use mod_inverse_ct for secret inputs.
+    template<uint32_t N, uint32_t N_significant>
+    std::optional<_uint<N,N_significant>> mod_inverse(const _uint_view<N,N_significant>& a, const _uint_view<N,N_significant>& m)
+    {
+        constexpr uint32_t n = _uint_view<N,N_significant>::significant_words_num;
+        if(__kernels::significant_size(m.value,n) == 0)
+            return std::nullopt;
+        _uint<N,N_significant> u(0), v(0);
+        __instrumentation::counted_vector<uint16_t> su(n+1,0), sv(n+1,0);
+        std::copy(m.value,m.value+n,u.value);
+        __kernels::divmod(nullptr,v.value,a.value,n,m.value,n);
+        sv[0] = 1;
+        bool odd = __kernels::lehmer_gcd(u.value,v.value,n,su.data(),sv.data(),n+1);
+        if(__kernels::significant_size(u.value,n) != 1 or u.value[0] != 1)
+            return std::nullopt;
+
+        // The cofactor of a paired with the i-th remainder has sign (-1)^(i+1).
+        std::copy(su.begin(),su.begin()+n,u.value);
+        if(not odd and __kernels::significant_size(u.value,n))
+        {
+            std::copy(m.value,m.value+n,v.value);
+            __kernels::sub_inplace(v.value,n,u.value,n);
+            return v;
+        }
+        return u;
+    }
+
+
+    // Constant time inverse of a modulo an odd m (Bernstein-Yang safegcd, divsteps batched
+    // into 2x2 transition matrices). The number of iterations depends only on N_significant,
+    // and the running time only on the operand types. Returns 0 if gcd(a,m) != 1.
+    template<uint32_t N, uint32_t N_significant>
+    _uint<N,N_significant> mod_inverse_ct(const _uint_view<N,N_significant>& a, const _uint_view<N,N_significant>& m)
+    {
+        constexpr uint32_t W = _uint_view<N,N_significant>::significant_words_num;
+        constexpr uint32_t L = W+1;
+        constexpr uint32_t d = N_significant;
+        constexpr uint32_t iterations = (49*d + (d < 46 ? 80 : 57)) / 17;
+        constexpr uint32_t batches = (iterations + __kernels::divsteps_batch - 1) / __kernels::divsteps_batch;
+        if(not (m.value[0] & 1))
+            throw std::domain_error("modulus must be odd");
+
+        uint32_t m_low = m.value[0] | (W > 1 ? (uint32_t)m.value[1] << __kernels::word_bits : 0);
+        uint32_t minv = m_low;
+        for(uint8_t i(0); i < 4; ++i)
+            minv *= 2 - m_low*minv;
+
+        uint16_t f[L] = {}, g[L] = {}, dc[L] = {}, ec[L] = {};
+        std::copy(m.value,m.value+W,f);
+        std::copy(a.value,a.value+W,g);
+        ec[0] = 1;
+        int64_t delta = 1;
+        for(uint32_t i(0); i < batches; ++i)
+        {
+            __kernels::divsteps_matrix t;
+            uint64_t f_low = f[0] | ((uint64_t)f[1] << __kernels::word_bits);
+            uint64_t g_low = g[0] | ((uint64_t)g[1] << __kernels::word_bits);
+            delta = __kernels::divsteps(delta,f_low,g_low,t);
+            __kernels::divsteps_update_fg<L>(f,g,t);
+            __kernels::divsteps_update_de<W>(dc,ec,m.value,minv,t);
+        }
+
+        // f = +-gcd(a,m) now and dc*a = f mod m.
+        uint16_t f_negative = -(f[L-1] >> 15);
+        uint16_t not_one = f[0] ^ 1, not_minus_one = 0;
+        for(uint32_t i(0); i < L; ++i)
+        {
+            if(i)
+                not_one |= f[i];
+            not_minus_one |= f[i] ^ uint16_t(0xffff);
+        }
+        uint16_t invertible = -(uint16_t)((((uint32_t)not_one - 1) >> 31) | (((uint32_t)not_minus_one - 1) >> 31));
+
+        uint16_t neg[L] = {};
+        std::copy(m.value,m.value+W,neg);
+        __kernels::sub_inplace(neg,L,dc,L);
+        __kernels::masked_reduce(neg,L,m.value,W);
+        _uint<N,N_significant> res(0);
+        for(uint32_t i(0); i < W; ++i)
+            res.value[i] = ((neg[i] & f_negative) | (dc[i] & ~f_negative)) & invertible;
+        return res;
+    }
+}
+
+#endif
@@ -4,12 +4,19 @@
 #include <array>
 #include <algorithm>
 #include <cstdint>
+#include <utility>
+#include <type_traits>
 
 namespace lrf
 {
     namespace __globals
     {
         constexpr uint32_t karatsuba_bound = 1 << 20;
+        // Operands up to this many bits go through the fixed size, fully unrolled kernels.
+        constexpr uint32_t unrolled_kernels_bound = 512;
+        // Operand block, in words, of the cache-blocked schoolbook multiplication used above
+        // unrolled_kernels_bound. A block pair with its column sums takes about 6 KB of L1.
+        constexpr uint32_t mul_block_words = 256;
 
         template<typename T>
         concept Iterator = std::input_iterator<T> and requires(T x) { { *x } -> std::same_as<bool>; };
@@ -53,6 +60,46 @@ namespace lrf
 
         constexpr uint32_t pow2(uint8_t x) { return powers_2[x]; }
 
+        // Loops over at most this many iterations are unrolled by unroll().
+        constexpr uint32_t unroll_bound = 64;
+
+        // Calls f(i) for i in [0,Count). i is an std::integral_constant when the loop is
+        // short enough to be unrolled at compile time, and a plain uint32_t otherwise.
+        template<uint32_t Count, typename F>
+        constexpr void unroll(F&& f)
+        {
+            if constexpr(Count <= unroll_bound)
+                [&]<uint32_t... I>(std::integer_sequence<uint32_t,I...>) { (f(std::integral_constant<uint32_t,I>{}), ...); }(std::make_integer_sequence<uint32_t,Count>{});
+            else
+                for(uint32_t i(0); i < Count; ++i)
+                    f(i);
+        }
+
+        // Hex string usable as a template argument, e.g. _mod_uint<256,"ffffffff00000001...">.
+        template<std::size_t L>
+        struct hex_literal
+        {
+            char digits[L];
+
+            constexpr hex_literal(const char (&str)[L]) { std::copy_n(str,L,digits); }
+
+            static constexpr std::size_t length = L-1;
+        };
+
+        template<uint32_t W, std::size_t L>
+        constexpr std::array<uint16_t,W> parse_hex(const hex_literal<L>& hex)
+        {
+            std::array<uint16_t,W> res{};
+            uint32_t bit = 0;
+            for(std::size_t i(L-1); i-- > 0; bit += 4)
+            {
+                char ch = hex.digits[i];
+                uint16_t digit = ch >= '0' and ch <= '9' ? ch-'0' : ch >= 'a' and ch <= 'f' ? ch-'a'+10 : ch-'A'+10;
+                res[bit/16] |= digit << (bit%16);
+            }
+            return res;
+        }
+
         template<uint32_t N, uint32_t N_significant, uint32_t M, uint32_t M_significant>
         constexpr uint32_t max_addition_output_significant_bits()
         {
@@ -0,0 +1,141 @@
+#ifndef LRF_INSTRUMENTATION_HPP
+#define LRF_INSTRUMENTATION_HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace lrf
+{
+    // Hot path counters, compiled in only when LRF_INSTRUMENTATION is defined (cmake -DLRF_INSTRUMENTATION=ON).
+    // Counters are per thread: a snapshot only reflects the work done by the calling thread.
+    // Without LRF_INSTRUMENTATION the hooks expand to nothing and snapshots are all zero.
+
+    enum class _uint_op : uint8_t
+    {
+        add,
+        sub,
+        mul,
+        div,
+        mod,
+        shift_left,
+        shift_right,
+        compare,
+        copy,
+        move,
+        assign,
+        convert,
+        count
+    };
+
+    enum class _mul_tier : uint8_t
+    {
+        unrolled,
+        schoolbook,
+        karatsuba,
+        count
+    };
+
+    struct _uint_counters
+    {
+        static constexpr bool enabled =
+#ifdef LRF_INSTRUMENTATION
+            true;
+#else
+            false;
+#endif
+
+        std::array<uint64_t,(std::size_t)_uint_op::count> ops{};
+        std::array<uint64_t,(std::size_t)_mul_tier::count> mul_tiers{};
+        // Heap allocations of _uint buffers and of the scratch vectors of the kernels
+        uint64_t allocations = 0;
+        uint64_t allocated_bytes = 0;
+        // 16x16 bit word products computed by multiplication and reduction kernels
+        uint64_t partial_products = 0;
+
+        uint64_t operator[](_uint_op op) const { return ops[(std::size_t)op]; }
+        uint64_t operator[](_mul_tier tier) const { return mul_tiers[(std::size_t)tier]; }
+
+        bool operator==(const _uint_counters&) const = default;
+    };
+
+
+    namespace __instrumentation
+    {
+#ifdef LRF_INSTRUMENTATION
+        inline _uint_counters& local_counters()
+        {
+            thread_local _uint_counters counters;
+            return counters;
+        }
+#endif
+    }
+
+
+    // Counters of the calling thread.
+    inline _uint_counters counters_snapshot()
+    {
+#ifdef LRF_INSTRUMENTATION
+        return __instrumentation::local_counters();
+#else
+        return {};
+#endif
+    }
+
+
+    inline void counters_reset()
+    {
+#ifdef LRF_INSTRUMENTATION
+        __instrumentation::local_counters() = {};
+#endif
+    }
+}
+
+#ifdef LRF_INSTRUMENTATION
+    #define LRF_COUNT_OP(op) (++lrf::__instrumentation::local_counters().ops[(std::size_t)lrf::_uint_op::op])
+    #define LRF_COUNT_MUL_TIER(tier) (++lrf::__instrumentation::local_counters().mul_tiers[(std::size_t)lrf::_mul_tier::tier])
+    #define LRF_COUNT_ALLOCATION(bytes) \
+        (++lrf::__instrumentation::local_counters().allocations, lrf::__instrumentation::local_counters().allocated_bytes += (bytes))
+    #define LRF_COUNT_PARTIAL_PRODUCTS(n) (lrf::__instrumentation::local_counters().partial_products += (n))
+#else
+    #define LRF_COUNT_OP(op) ((void)0)
+    #define LRF_COUNT_MUL_TIER(tier) ((void)0)
+    #define LRF_COUNT_ALLOCATION(bytes) ((void)0)
+    #define LRF_COUNT_PARTIAL_PRODUCTS(n) ((void)0)
+#endif
+
+namespace lrf
+{
+    namespace __instrumentation
+    {
+        // std::allocator that reports every allocation to LRF_COUNT_ALLOCATION
+        template<typename T>
+        struct counting_allocator
+        {
+            typedef T value_type;
+
+            counting_allocator() = default;
+            template<typename U>
+            counting_allocator(const counting_allocator<U>&) {}
+
+            T *allocate(std::size_t n)
+            {
+                LRF_COUNT_ALLOCATION(n*sizeof(T));
+                return std::allocator<T>().allocate(n);
+            }
+
+            void deallocate(T *p, std::size_t n) { std::allocator<T>().deallocate(p,n); }
+
+            template<typename U>
+            bool operator==(const counting_allocator<U>&) const { return true; }
+        };
+
+
+        // Vector for library scratch space, so that its allocations show up in the counters
+        template<typename T>
+        using counted_vector = std::vector<T,counting_allocator<T>>;
+    }
+}
+
+#endif
@@ -0,0 +1,512 @@
+#ifndef LRF_KERNELS_HPP
+#define LRF_KERNELS_HPP
+
+#include <cstdint>
+#include <algorithm>
+#include <bit>
+#include <vector>
+#include "globals.hpp"
+#include "instrumentation.hpp"
+
+namespace lrf
+{
+    namespace __kernels
+    {
+        constexpr uint8_t word_bits = 16;
+        constexpr uint32_t word_mask = 0xffff;
+
+
+        inline uint32_t significant_size(const uint16_t *a, uint32_t n)
+        {
+            while(n and a[n-1] == 0)
+                --n;
+            return n;
+        }
+
+
+        inline uint32_t bit_length(const uint16_t *a, uint32_t n)
+        {
+            n = significant_size(a,n);
+            return n ? (n-1)*word_bits + std::bit_width(a[n-1]) : 0;
+        }
+
+
+        inline int compare(const uint16_t *a, uint32_t an, const uint16_t *b, uint32_t bn)
+        {
+            an = significant_size(a,an);
+            bn = significant_size(b,bn);
+            if(an != bn)
+                return an < bn ? -1 : 1;
+            for(uint32_t i(an); i-- > 0;)
+                if(a[i] != b[i])
+                    return a[i] < b[i] ? -1 : 1;
+            return 0;
+        }
+
+
+        // a[0..n) += b[0..bn), bn <= n. Returns carry out of the top word.
+        inline uint16_t add_inplace(uint16_t *a, uint32_t n, const uint16_t *b, uint32_t bn)
+        {
+            uint32_t r = 0;
+            for(uint32_t i(0); i < bn; ++i)
+            {
+                uint32_t word_sum = (uint32_t)a[i] + (uint32_t)b[i] + r;
+                a[i] = word_sum & word_mask;
+                r = word_sum >> word_bits;
+            }
+            for(uint32_t i(bn); i < n and r; ++i)
+            {
+                uint32_t word_sum = (uint32_t)a[i] + r;
+                a[i] = word_sum & word_mask;
+                r = word_sum >> word_bits;
+            }
+            return r;
+        }
+
+
+        // a[0..n) -= b[0..bn), bn <= n. Returns borrow out of the top word.
+        inline uint16_t sub_inplace(uint16_t *a, uint32_t n, const uint16_t *b, uint32_t bn)
+        {
+            uint32_t r = 0;
+            for(uint32_t i(0); i < bn; ++i)
+            {
+                uint32_t word_diff = (uint32_t)a[i] - (uint32_t)b[i] - r;
+                a[i] = word_diff & word_mask;
+                r = word_diff >> 31;
+            }
+            for(uint32_t i(bn); i < n and r; ++i)
+            {
+                uint32_t word_diff = (uint32_t)a[i] - r;
+                a[i] = word_diff & word_mask;
+                r = word_diff >> 31;
+            }
+            return r;
+        }
+
+
+        // res[0..n) = a[0..n) << bits, truncated to n words. res may alias a.
+        inline void shift_left(uint16_t *res, const uint16_t *a, uint32_t n, uint32_t bits)
+        {
+            uint32_t word_shift = bits / word_bits;
+            uint8_t bit_shift = bits % word_bits;
+            for(uint32_t i(n); i-- > 0;)
+            {
+                uint32_t hi = i >= word_shift ? a[i-word_shift] : 0;
+                uint32_t lo = i >= word_shift+1 ? a[i-word_shift-1] : 0;
+                res[i] = (((hi << word_bits) | lo) >> (word_bits - bit_shift)) & word_mask;
+            }
+        }
+
+
+        // res[0..n) = a[0..n) >> bits. res may alias a.
+        inline void shift_right(uint16_t *res, const uint16_t *a, uint32_t n, uint32_t bits)
+        {
+            uint32_t word_shift = bits / word_bits;
+            uint8_t bit_shift = bits % word_bits;
+            for(uint32_t i(0); i < n; ++i)
+            {
+                uint32_t lo = i+word_shift < n ? a[i+word_shift] : 0;
+                uint32_t hi = i+word_shift+1 < n ? a[i+word_shift+1] : 0;
+                res[i] = (((hi << word_bits) | lo) >> bit_shift) & word_mask;
+            }
+        }
+
+
+        // Bits [shift,shift+64) of a[0..n) as a single integer.
+        inline uint64_t extract_bits(const uint16_t *a, uint32_t n, uint32_t shift)
+        {
+            uint64_t res = 0;
+            uint32_t word_shift = shift / word_bits;
+            uint8_t bit_shift = shift % word_bits;
+            for(uint32_t i(0); i*word_bits < 64u+bit_shift and word_shift+i < n; ++i)
+            {
+                uint64_t w = a[word_shift+i];
+                if(i*word_bits >= bit_shift)
+                    res |= w << (i*word_bits - bit_shift);
+                else
+                    res |= w >> (bit_shift - i*word_bits);
+            }
+            return res;
+        }
+
+
+        // wyhash's secrets and mixing step: the 64x64 bit product folded to 64 bits.
+        constexpr uint64_t hash_secret[4] = {0xa0761d6478bd642full,0xe7037ed1a0b428dbull,0x8ebc6af09c88c6e3ull,0x589965cc75374cc3ull};
+
+        inline uint64_t hash_mix(uint64_t a, uint64_t b)
+        {
+#ifdef __SIZEOF_INT128__
+            __extension__ typedef unsigned __int128 uint128_t;
+            uint128_t p = (uint128_t)a * b;
+            return uint64_t(p) ^ uint64_t(p >> 64);
+#else
+            uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32, b_lo = b & 0xffffffff, b_hi = b >> 32;
+            uint64_t lo_lo = a_lo*b_lo, hi_lo = a_hi*b_lo, lo_hi = a_lo*b_hi;
+            uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+            uint64_t lo = (cross << 32) | (lo_lo & 0xffffffff);
+            uint64_t hi = a_hi*b_hi + (hi_lo >> 32) + (cross >> 32);
+            return lo ^ hi;
+#endif
+        }
+
+
+        // Words [i,i+4) of a as one 64 bit chunk. Compiles to a single load on little endian targets.
+        inline uint64_t hash_chunk(const uint16_t *a, uint32_t i)
+        {
+            return uint64_t(a[i]) | uint64_t(a[i+1]) << 16 | uint64_t(a[i+2]) << 32 | uint64_t(a[i+3]) << 48;
+        }
+
+
+        // Hash of the value of a[0..n), wyhash style. Trailing zero words are dropped first, so
+        // equal values of any width hash equally. 256 bit stripes go through two independent
+        // lanes to keep both multipliers busy.
+        inline uint64_t hash(const uint16_t *a, uint32_t n)
+        {
+            n = significant_size(a,n);
+            uint64_t lane_0 = hash_secret[0] ^ hash_mix(n ^ hash_secret[0],hash_secret[1]), lane_1 = lane_0 ^ hash_secret[3];
+            uint32_t i(0);
+            for(; i+16 <= n; i += 16)
+            {
+                lane_0 = hash_mix(hash_chunk(a,i) ^ hash_secret[1],hash_chunk(a,i+4) ^ lane_0);
+                lane_1 = hash_mix(hash_chunk(a,i+8) ^ hash_secret[2],hash_chunk(a,i+12) ^ lane_1);
+            }
+            uint64_t seed = lane_0 ^ lane_1;
+            for(; i+8 <= n; i += 8)
+                seed = hash_mix(hash_chunk(a,i) ^ hash_secret[1],hash_chunk(a,i+4) ^ seed);
+            // Up to 7 words left, zero padded into two chunks
+            uint16_t tail[8] = {};
+            std::copy(a+i,a+n,tail);
+            uint64_t x = hash_mix(hash_chunk(tail,0) ^ hash_secret[1],hash_chunk(tail,4) ^ seed);
+            return hash_mix(x ^ hash_secret[0] ^ n,hash_secret[1]);
+        }
+
+
+        // res[0..n) += a[0..n)*m. Returns the carry word.
+        inline uint16_t mul_word_add(uint16_t *res, const uint16_t *a, uint32_t n, uint16_t m)
+        {
+            LRF_COUNT_PARTIAL_PRODUCTS(n);
+            uint32_t r = 0;
+            for(uint32_t i(0); i < n; ++i)
+            {
+                uint32_t t = (uint32_t)a[i]*m + res[i] + r;
+                res[i] = t & word_mask;
+                r = t >> word_bits;
+            }
+            return r;
+        }
+
+
+        // Words of b multiplied per step of mul_block(). A compile time count lets the step
+        // vectorize without a scalar tail.
+        constexpr uint32_t mul_block_step = 32;
+
+        // acc[0..an+bn) += column sums of a[0..an)*b[0..bn), row by row, correct at least for the
+        // columns below len. bn must be a multiple of mul_block_step.
+        inline void mul_block(uint64_t *acc, const uint16_t *a, uint32_t an, const uint16_t *b, uint32_t bn, uint32_t len)
+        {
+            for(uint32_t i(0); i < an and i < len; ++i)
+            {
+                uint32_t a_v = a[i];
+                uint32_t j_bound = std::min(bn,len-i);
+                LRF_COUNT_PARTIAL_PRODUCTS((j_bound+mul_block_step-1)/mul_block_step*mul_block_step);
+                for(uint32_t j(0); j < j_bound; j += mul_block_step)
+                {
+                    uint64_t *c = acc+i+j;
+                    const uint16_t *b_step = b+j;
+                    for(uint32_t k(0); k < mul_block_step; ++k)
+                        c[k] += a_v*b_step[k];
+                }
+            }
+        }
+
+
+        // res[0..rn) = a*b modulo 2^(16rn), cache-blocked schoolbook multiplication. Operands are
+        // cut into mul_block_words blocks, every block pair is multiplied by mul_block() into
+        // column sums that stay in L1 and is then carried into res. The last block of b is zero
+        // padded to a whole number of steps. Block pairs entirely above rn are skipped.
+        // res must not alias the operands.
+        inline void mul_blocked(uint16_t *res, const uint16_t *a, uint32_t an, const uint16_t *b, uint32_t bn, uint32_t rn)
+        {
+            constexpr uint32_t block = __globals::mul_block_words;
+            static_assert(block % mul_block_step == 0);
+            uint64_t acc[2*block];
+            uint16_t product[2*block];
+            uint16_t b_tail[block];
+            std::fill(res,res+rn,0);
+            for(uint32_t j(0); j < bn and j < rn; j += block)
+            {
+                uint32_t b_len = std::min(block,bn-j);
+                const uint16_t *b_block = b+j;
+                if(b_len % mul_block_step)
+                {
+                    uint32_t padded = (b_len/mul_block_step+1)*mul_block_step;
+                    std::copy(b+j,b+j+b_len,b_tail);
+                    std::fill(b_tail+b_len,b_tail+padded,0);
+                    b_block = b_tail;
+                    b_len = padded;
+                }
+                for(uint32_t i(0); i < an and i+j < rn; i += block)
+                {
+                    uint32_t a_len = std::min(block,an-i);
+                    uint32_t len = std::min(a_len+b_len,rn-i-j);
+                    std::fill(acc,acc+a_len+b_len,0);
+                    mul_block(acc,a+i,a_len,b_block,b_len,len);
+                    uint64_t carry = 0;
+                    for(uint32_t k(0); k < len; ++k)
+                    {
+                        carry += acc[k];
+                        product[k] = carry & word_mask;
+                        carry >>= word_bits;
+                    }
+                    add_inplace(res+i+j,rn-i-j,product,len);
+                }
+            }
+        }
+
+
+        // res[0..an+bn) = a*b. res must not alias the operands.
+        inline void mul(uint16_t *res, const uint16_t *a, uint32_t an, const uint16_t *b, uint32_t bn)
+        {
+            mul_blocked(res,a,an,b,bn,an+bn);
+        }
+
+
+        // res[0..2n) = a^2. The cross products a[i]*a[j], i < j, are accumulated row by row,
+        // then doubled in one pass that also adds the squares a[i]^2. res must not alias a.
+        inline void sqr(uint16_t *res, const uint16_t *a, uint32_t n)
+        {
+            LRF_COUNT_PARTIAL_PRODUCTS(uint64_t(n)*(n+1)/2);
+            std::fill(res,res+2*n,0);
+            for(uint32_t i(0); i < n; ++i)
+            {
+                uint32_t carry = 0;
+                for(uint32_t j(i+1); j < n; ++j)
+                {
+                    uint32_t s = (uint32_t)res[i+j] + (uint32_t)a[i]*a[j] + carry;
+                    res[i+j] = s & word_mask;
+                    carry = s >> word_bits;
+                }
+                res[i+n] = carry;
+            }
+            uint32_t carry = 0;
+            for(uint32_t i(0); i < n; ++i)
+            {
+                uint64_t square = (uint32_t)a[i]*a[i];
+                uint64_t lo = ((uint64_t)res[2*i] << 1) + (square & word_mask) + carry;
+                uint64_t hi = ((uint64_t)res[2*i+1] << 1) + (square >> word_bits) + (lo >> word_bits);
+                res[2*i] = lo & word_mask;
+                res[2*i+1] = hi & word_mask;
+                carry = hi >> word_bits;
+            }
+        }
+
+
+        // res[0..n) = a*u + b*v for signed single-precision cofactors. The result must be
+        // non-negative and fit in n words. Reads a[i],b[i] before writing res[i],
+        // so res may alias either operand.
+        inline void linear_combination(uint16_t *res, const uint16_t *a, const uint16_t *b, uint32_t n, int64_t u, int64_t v)
+        {
+            int64_t carry = 0;
+            for(uint32_t i(0); i < n; ++i)
+            {
+                int64_t t = u*a[i] + v*b[i] + carry;
+                res[i] = t & word_mask;
+                carry = t >> word_bits;
+            }
+        }
+
+
+        // Long division (Knuth, TAOCP vol. 2, 4.3.1, algorithm D).
+        // q[0..un) = u / v, r[0..vn) = u % v. v must be non-zero.
+        // q and r must not alias the operands; either may be null. scratch, if given, must hold
+        // un+vn+1 words; otherwise the normalized operands are kept in heap buffers.
+        inline void divmod(uint16_t *q, uint16_t *r, const uint16_t *u, uint32_t un, const uint16_t *v, uint32_t vn, uint16_t *scratch = nullptr)
+        {
+            uint32_t q_size = un, r_size = vn;
+            if(q)
+                std::fill(q,q+q_size,0);
+            if(r)
+                std::fill(r,r+r_size,0);
+            un = significant_size(u,un);
+            vn = significant_size(v,vn);
+            if(un < vn)
+            {
+                if(r)
+                    std::copy(u,u+un,r);
+                return;
+            }
+            if(vn == 1)
+            {
+                uint32_t rem = 0;
+                for(uint32_t i(un); i-- > 0;)
+                {
+                    uint32_t num = (rem << word_bits) | u[i];
+                    if(q)
+                        q[i] = num / v[0];
+                    rem = num % v[0];
+                }
+                if(r)
+                    r[0] = rem;
+                return;
+            }
+
+            __instrumentation::counted_vector<uint16_t> buffer;
+            if(!scratch)
+            {
+                buffer.resize(un+vn+1);
+                scratch = buffer.data();
+            }
+            uint16_t *vn_ = scratch, *un_ = scratch+vn;
+            uint8_t s = std::countl_zero(v[vn-1]);
+            shift_left(vn_,v,vn,s);
+            std::copy(u,u+un,un_);
+            un_[un] = 0;
+            shift_left(un_,un_,un+1,s);
+
+            LRF_COUNT_PARTIAL_PRODUCTS((un-vn+1)*vn);
+            uint64_t v_top = vn_[vn-1], v_next = vn_[vn-2];
+            for(uint32_t j(un-vn+1); j-- > 0;)
+            {
+                uint64_t num = ((uint64_t)un_[j+vn] << word_bits) | un_[j+vn-1];
+                uint64_t qhat = num / v_top, rhat = num % v_top;
+                while(qhat > word_mask or qhat*v_next > ((rhat << word_bits) | un_[j+vn-2]))
+                {
+                    --qhat;
+                    rhat += v_top;
+                    if(rhat > word_mask)
+                        break;
+                }
+
+                int64_t borrow = 0;
+                uint64_t carry = 0;
+                for(uint32_t i(0); i < vn; ++i)
+                {
+                    uint64_t p = qhat*vn_[i] + carry;
+                    carry = p >> word_bits;
+                    int64_t t = (int64_t)un_[i+j] - (int64_t)(p & word_mask) - borrow;
+                    un_[i+j] = t & word_mask;
+                    borrow = t < 0;
+                }
+                int64_t t = (int64_t)un_[j+vn] - (int64_t)carry - borrow;
+                un_[j+vn] = t & word_mask;
+
+                if(t < 0)
+                {
+                    --qhat;
+                    un_[j+vn] += add_inplace(un_+j,vn,vn_,vn);
+                }
+                if(q)
+                    q[j] = qhat;
+            }
+            if(r)
+                shift_right(r,un_,vn,s);
+        }
+
+
+        // Fixed size kernels. Word counts are template parameters so that short loops are
+        // unrolled into straight-line carry chains (see __globals::unroll).
+
+        // res[0..R) = a[0..A) + b[0..B), truncated to R words. Returns the carry out of
+        // the top word. res may alias the operands.
+        template<uint32_t A, uint32_t B = A, uint32_t R = std::max(A,B)>
+        uint16_t add_n(uint16_t *res, const uint16_t *a, const uint16_t *b)
+        {
+            uint32_t r = 0;
+            __globals::unroll<R>([&](auto i)
+            {
+                uint32_t word_sum = r;
+                if(i < A)
+                    word_sum += a[i];
+                if(i < B)
+                    word_sum += b[i];
+                res[i] = word_sum & word_mask;
+                r = word_sum >> word_bits;
+            });
+            return r;
+        }
+
+
+        // res[0..R) = a[0..A) - b[0..B) modulo 2^(16R). Returns the borrow out of the top word.
+        // res may alias the operands.
+        template<uint32_t A, uint32_t B = A, uint32_t R = std::max(A,B)>
+        uint16_t sub_n(uint16_t *res, const uint16_t *a, const uint16_t *b)
+        {
+            uint32_t r = 0;
+            __globals::unroll<R>([&](auto i)
+            {
+                uint32_t word_diff = -r;
+                if(i < A)
+                    word_diff += a[i];
+                if(i < B)
+                    word_diff -= b[i];
+                res[i] = word_diff & word_mask;
+                r = word_diff >> 31;
+            });
+            return r;
+        }
+
+
+        // res[0..W) = mask ? a : b, without branching on mask (0 or 0xffff).
+        template<uint32_t W>
+        void select_n(uint16_t *res, uint16_t mask, const uint16_t *a, const uint16_t *b)
+        {
+            __globals::unroll<W>([&](auto i) { res[i] = (a[i] & mask) | (b[i] & ~mask); });
+        }
+
+
+        // Number of word products a[i]*b[j], i < A, j < B, i+j < R.
+        constexpr uint64_t mul_n_products(uint32_t A, uint32_t B, uint32_t R)
+        {
+            uint64_t res = 0;
+            for(uint32_t i(0); i < std::min(A,R); ++i)
+                res += std::min(B,R-i);
+            return res;
+        }
+
+
+        // res[0..R) = a[0..A)*b[0..B) modulo 2^(16R), product scanning (Comba): every column
+        // is summed into a 64 bit accumulator and carried once. res must not alias the operands.
+        template<uint32_t A, uint32_t B = A, uint32_t R = A+B>
+        void mul_n(uint16_t *res, const uint16_t *a, const uint16_t *b)
+        {
+            LRF_COUNT_PARTIAL_PRODUCTS(mul_n_products(A,B,R));
+            uint64_t acc = 0;
+            __globals::unroll<R>([&](auto k)
+            {
+                __globals::unroll<A>([&](auto i)
+                {
+                    if(i <= k and k-i < B)
+                        acc += (uint32_t)a[i]*b[k-i];
+                });
+                res[k] = acc & word_mask;
+                acc >>= word_bits;
+            });
+        }
+
+
+        // res[0..2W) = a^2. Cross products are summed once and doubled.
+        template<uint32_t W>
+        void sqr_n(uint16_t *res, const uint16_t *a)
+        {
+            LRF_COUNT_PARTIAL_PRODUCTS(W*(W+1)/2);
+            uint64_t acc = 0;
+            __globals::unroll<2*W-1>([&](auto k)
+            {
+                uint64_t cross = 0;
+                __globals::unroll<W>([&](auto i)
+                {
+                    if(i < k-i and k-i < W)
+                        cross += (uint32_t)a[i]*a[k-i];
+                });
+                acc += 2*cross;
+                if(k % 2 == 0)
+                    acc += (uint32_t)a[k/2]*a[k/2];
+                res[k] = acc & word_mask;
+                acc >>= word_bits;
+            });
+            res[2*W-1] = acc;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,564 @@
+#ifndef LRF_MOD_UINT_HPP
+#define LRF_MOD_UINT_HPP
+
+#include "uint.hpp"
+#include "gcd.hpp"
+
+namespace lrf
+{
+    enum class _mod_reduction { pseudo_mersenne, montgomery, barrett };
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    class _mod_uint;
+
+    // ===BEGIN TYPEDEFS===
+
+    typedef _mod_uint<256,"ffffffff00000001000000000000000000000000ffffffffffffffffffffffff"> p256_field_t;
+    typedef _mod_uint<256,"fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f"> secp256k1_field_t;
+    typedef _mod_uint<256,"7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed"> curve25519_field_t;
+
+    // ===END TYPEDEFS===
+
+    namespace __kernels
+    {
+        // res[0..W) = t[0..W) - p if t_top:t >= p, t otherwise. Requires t_top:t < 2p.
+        template<uint32_t W>
+        void reduce_once(uint16_t *res, const uint16_t *t, uint16_t t_top, const uint16_t *p)
+        {
+            uint16_t diff[W];
+            uint16_t borrow = sub_n<W>(diff,t,p);
+            select_n<W>(res,-(uint16_t)((t_top | (borrow ^ 1)) & 1),diff,t);
+        }
+
+
+        // res = a*b*R^-1 mod p, R = 2^(16W), a,b < p (Montgomery multiplication, CIOS:
+        // every row of the product is reduced right after it is accumulated).
+        // p_inv = -p^-1 mod 2^16. res may alias the operands.
+        template<uint32_t W>
+        void mont_mul(uint16_t *res, const uint16_t *a, const uint16_t *b, const uint16_t *p, uint16_t p_inv)
+        {
+            LRF_COUNT_PARTIAL_PRODUCTS(2*W*W);
+            uint16_t t[W+2] = {};
+            __globals::unroll<W>([&](auto i)
+            {
+                uint32_t carry = 0;
+                __globals::unroll<W>([&](auto j)
+                {
+                    uint32_t s = (uint32_t)t[j] + (uint32_t)a[j]*b[i] + carry;
+                    t[j] = s & word_mask;
+                    carry = s >> word_bits;
+                });
+                uint32_t s = (uint32_t)t[W] + carry;
+                t[W] = s & word_mask;
+                t[W+1] = s >> word_bits;
+
+                uint16_t m = (uint32_t)t[0]*p_inv;
+                carry = ((uint32_t)t[0] + (uint32_t)m*p[0]) >> word_bits;
+                __globals::unroll<W-1>([&](auto j)
+                {
+                    uint32_t s = (uint32_t)t[j+1] + (uint32_t)m*p[j+1] + carry;
+                    t[j] = s & word_mask;
+                    carry = s >> word_bits;
+                });
+                s = (uint32_t)t[W] + carry;
+                t[W-1] = s & word_mask;
+                t[W] = t[W+1] + (s >> word_bits);
+            });
+            reduce_once<W>(res,t,t[W],p);
+        }
+
+
+        // res = x*R^-1 mod p for a 2W word x < p*R (Montgomery reduction).
+        template<uint32_t W>
+        void mont_reduce(uint16_t *res, const uint16_t *x, const uint16_t *p, uint16_t p_inv)
+        {
+            LRF_COUNT_PARTIAL_PRODUCTS(W*W);
+            uint16_t t[2*W];
+            std::copy(x,x+2*W,t);
+            uint32_t top_carry = 0;
+            __globals::unroll<W>([&](auto i)
+            {
+                uint16_t m = (uint32_t)t[i]*p_inv;
+                uint32_t carry = 0;
+                __globals::unroll<W>([&](auto j)
+                {
+                    uint32_t s = (uint32_t)t[i+j] + (uint32_t)m*p[j] + carry;
+                    t[i+j] = s & word_mask;
+                    carry = s >> word_bits;
+                });
+                uint32_t s = (uint32_t)t[i+W] + carry + top_carry;
+                t[i+W] = s & word_mask;
+                top_carry = s >> word_bits;
+            });
+            reduce_once<W>(res,t+W,top_carry,p);
+        }
+
+
+        // hi[0..H) = x >> K, x[0..X) is cut down to its lowest K bits.
+        template<uint32_t K, uint32_t X, uint32_t H>
+        void split_bits(uint16_t *hi, uint16_t *x)
+        {
+            constexpr uint32_t word_shift = K / word_bits;
+            constexpr uint8_t bit_shift = K % word_bits;
+            __globals::unroll<H>([&](auto i)
+            {
+                uint32_t lo_word = i+word_shift < X ? x[i+word_shift] : 0;
+                uint32_t hi_word = i+word_shift+1 < X ? x[i+word_shift+1] : 0;
+                hi[i] = (((hi_word << word_bits) | lo_word) >> bit_shift) & word_mask;
+            });
+            __globals::unroll<X>([&](auto i)
+            {
+                if(i > word_shift or (i == word_shift and bit_shift == 0))
+                    x[i] = 0;
+                else if(i == word_shift)
+                    x[i] &= (1 << bit_shift) - 1;
+            });
+        }
+
+
+        // x[0..X) = (x mod 2^K) + (x >> K)*c, for the pseudo-Mersenne modulus 2^K - c.
+        // c has C significant words, the result must fit in X words.
+        template<uint32_t K, uint32_t X, uint32_t C>
+        void fold(uint16_t *x, const uint16_t *c)
+        {
+            constexpr uint32_t H = X - K/word_bits;
+            uint16_t hi[H];
+            split_bits<K,X,H>(hi,x);
+            __globals::unroll<C>([&](auto j)
+            {
+                uint32_t carry = 0;
+                __globals::unroll<H>([&](auto i)
+                {
+                    if(i+j < X)
+                    {
+                        uint32_t s = (uint32_t)x[i+j] + (uint32_t)hi[i]*c[j] + carry;
+                        x[i+j] = s & word_mask;
+                        carry = s >> word_bits;
+                    }
+                });
+                __globals::unroll<X>([&](auto i)
+                {
+                    if(i >= H+j)
+                    {
+                        uint32_t s = (uint32_t)x[i] + carry;
+                        x[i] = s & word_mask;
+                        carry = s >> word_bits;
+                    }
+                });
+            });
+        }
+    }
+
+
+    // Element of the prime field Z/pZ for a modulus p < 2^N fixed at compile time.
+    // The reduction is picked from the shape of p:
+    //  - p = 2^k - c with c < 2^(k/2-1): pseudo-Mersenne folding (secp256k1, 2^255-19),
+    //  - any other odd p: Montgomery multiplication, elements are kept in Montgomery form,
+    //  - even p: Barrett reduction.
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    class _mod_uint
+    {
+    public:
+        typedef uint16_t word_type;
+        static constexpr uint8_t word_bits = sizeof(word_type) * 8;
+        static constexpr uint32_t words_num = N / word_bits;
+
+        static_assert(Modulus.length <= words_num*word_bits/4, "modulus does not fit in N bits");
+        static constexpr std::array<uint16_t,words_num> modulus = __globals::parse_hex<words_num>(Modulus);
+
+    private:
+        static constexpr uint32_t modulus_words_num = []
+        {
+            uint32_t n = words_num;
+            while(n and modulus[n-1] == 0)
+                --n;
+            return n;
+        }();
+        static constexpr uint32_t modulus_bits = (modulus_words_num-1)*word_bits + std::bit_width(modulus[modulus_words_num-1]);
+        static_assert(modulus_bits > 1, "modulus must be greater than 1");
+
+        // c = 2^modulus_bits - p
+        static constexpr std::array<uint16_t,words_num+1> pseudo_mersenne_c = []
+        {
+            std::array<uint16_t,words_num+1> c{};
+            c[modulus_bits/word_bits] = 1 << (modulus_bits%word_bits);
+            uint32_t r = 0;
+            for(uint32_t i(0); i < words_num+1; ++i)
+            {
+                uint32_t word_diff = (uint32_t)c[i] - (uint32_t)(i < words_num ? modulus[i] : 0) - r;
+                c[i] = word_diff & 0xffff;
+                r = word_diff >> 31;
+            }
+            return c;
+        }();
+        static constexpr uint32_t pseudo_mersenne_c_bits = []
+        {
+            uint32_t n = words_num+1;
+            while(n and pseudo_mersenne_c[n-1] == 0)
+                --n;
+            return (n-1)*word_bits + std::bit_width(pseudo_mersenne_c[n-1]);
+        }();
+        static constexpr uint32_t pseudo_mersenne_c_words_num = (pseudo_mersenne_c_bits + word_bits - 1) / word_bits;
+
+    public:
+        static constexpr _mod_reduction reduction = pseudo_mersenne_c_bits + 1 < modulus_bits/2 ? _mod_reduction::pseudo_mersenne
+                                                  : modulus[0] & 1 ? _mod_reduction::montgomery
+                                                  : _mod_reduction::barrett;
+
+    private:
+        // -p^-1 mod 2^16
+        static constexpr uint16_t montgomery_p_inv = []
+        {
+            uint32_t inv = modulus[0];
+            for(uint8_t i(0); i < 4; ++i)
+                inv *= 2 - modulus[0]*inv;
+            return (uint16_t)-inv;
+        }();
+
+        // R^2 mod p, R = 2^N, by doubling
+        static constexpr std::array<uint16_t,words_num> montgomery_r2 = []
+        {
+            std::array<uint16_t,words_num+1> r{};
+            r[0] = 1;
+            for(uint32_t bit(0); bit < 2*N; ++bit)
+            {
+                uint32_t carry = 0;
+                for(uint32_t i(0); i < words_num+1; ++i)
+                {
+                    uint32_t w = ((uint32_t)r[i] << 1) | carry;
+                    r[i] = w & 0xffff;
+                    carry = w >> word_bits;
+                }
+                std::array<uint16_t,words_num+1> diff{};
+                uint32_t borrow = 0;
+                for(uint32_t i(0); i < words_num+1; ++i)
+                {
+                    uint32_t word_diff = (uint32_t)r[i] - (uint32_t)(i < words_num ? modulus[i] : 0) - borrow;
+                    diff[i] = word_diff & 0xffff;
+                    borrow = word_diff >> 31;
+                }
+                if(not borrow)
+                    r = diff;
+            }
+            std::array<uint16_t,words_num> res{};
+            std::copy(r.begin(),r.begin()+words_num,res.begin());
+            return res;
+        }();
+
+        // floor(2^(32*k) / p), k = modulus_words_num (Barrett's constant)
+        static constexpr std::array<uint16_t,words_num+1> barrett_mu = []
+        {
+            constexpr uint32_t k = modulus_words_num;
+            std::array<uint16_t,words_num+1> q{}, r{};
+            for(uint32_t bit(2*k*word_bits+1); bit-- > 0;)
+            {
+                uint32_t carry = bit == 2*k*word_bits;
+                for(uint32_t i(0); i < words_num+1; ++i)
+                {
+                    uint32_t w = ((uint32_t)r[i] << 1) | carry;
+                    r[i] = w & 0xffff;
+                    carry = w >> word_bits;
+                }
+                std::array<uint16_t,words_num+1> diff{};
+                uint32_t borrow = 0;
+                for(uint32_t i(0); i < words_num+1; ++i)
+                {
+                    uint32_t word_diff = (uint32_t)r[i] - (uint32_t)(i < words_num ? modulus[i] : 0) - borrow;
+                    diff[i] = word_diff & 0xffff;
+                    borrow = word_diff >> 31;
+                }
+                if(not borrow)
+                {
+                    r = diff;
+                    q[bit/word_bits] |= 1 << (bit%word_bits);
+                }
+            }
+            return q;
+        }();
+
+        _uint<N> repr;
+
+        // res = x mod p for a 2W word x < p^2
+        static void reduce(uint16_t *res, uint16_t *x);
+        static void to_repr(uint16_t *res, const uint16_t *x);
+        static void from_repr(uint16_t *res, const uint16_t *x);
+
+    public:
+        _mod_uint();
+        _mod_uint(uint64_t value);
+        _mod_uint(const std::string_view hex_str);
+        template<uint32_t M, uint32_t M_significant>
+        _mod_uint(const _uint_view<M,M_significant>& x);
+        _mod_uint(const _mod_uint<N,Modulus>&);
+        _mod_uint(_mod_uint<N,Modulus>&&);
+
+        _mod_uint<N,Modulus>& operator=(const _mod_uint<N,Modulus>&);
+
+        // Canonical representative in [0,p)
+        _uint<N> value() const;
+        operator std::string() const;
+
+        _mod_uint<N,Modulus> operator+(const _mod_uint<N,Modulus>& other) const;
+        _mod_uint<N,Modulus> operator-(const _mod_uint<N,Modulus>& other) const;
+        _mod_uint<N,Modulus> operator*(const _mod_uint<N,Modulus>& other) const;
+        _mod_uint<N,Modulus>& operator+=(const _mod_uint<N,Modulus>& other);
+        _mod_uint<N,Modulus>& operator-=(const _mod_uint<N,Modulus>& other);
+        _mod_uint<N,Modulus>& operator*=(const _mod_uint<N,Modulus>& other);
+
+        _mod_uint<N,Modulus> square() const;
+        // Multiplicative inverse, 0 if there is none. Constant time for odd moduli.
+        _mod_uint<N,Modulus> inverse() const;
+
+        bool operator==(const _mod_uint<N,Modulus>& other) const;
+    };
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    void _mod_uint<N,Modulus>::reduce(uint16_t *res, uint16_t *x)
+    {
+        constexpr uint32_t W = words_num;
+        if constexpr(reduction == _mod_reduction::pseudo_mersenne)
+        {
+            constexpr uint32_t K = modulus_bits;
+            constexpr uint32_t C = pseudo_mersenne_c_words_num;
+            // x < 2^2K; after the first fold x < 2^(K+c_bits+1), after the second x < 2p.
+            // c_bits+1 < K/2, so the second fold never needs more than the 2W words of x.
+            __kernels::fold<K,2*W,C>(x,pseudo_mersenne_c.data());
+            __kernels::fold<K,std::min(W+C+1,2*W),C>(x,pseudo_mersenne_c.data());
+            __kernels::reduce_once<W>(res,x,x[W],modulus.data());
+        }
+        else if constexpr(reduction == _mod_reduction::montgomery)
+            __kernels::mont_reduce<W>(res,x,modulus.data(),montgomery_p_inv);
+        else
+        {
+            // Barrett (Menezes et al., Handbook of Applied Cryptography, 14.42) with k = words of p.
+            constexpr uint32_t k = modulus_words_num;
+            // Only the low k+1 words of q3*p are needed, r is taken modulo 2^(16(k+1))
+            uint16_t q2[2*k+2], q3p[k+1], r[k+1];
+            __kernels::mul_n<k+1>(q2,x+k-1,barrett_mu.data());
+            __kernels::mul_n<k+1,k,k+1>(q3p,q2+k+1,modulus.data());
+            std::copy(x,x+k+1,r);
+            __kernels::sub_n<k+1>(r,r,q3p);
+            __kernels::masked_reduce(r,k+1,modulus.data(),k);
+            __kernels::masked_reduce(r,k+1,modulus.data(),k);
+            std::copy(r,r+k,res);
+            std::fill(res+k,res+W,0);
+        }
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    void _mod_uint<N,Modulus>::to_repr(uint16_t *res, const uint16_t *x)
+    {
+        if constexpr(reduction == _mod_reduction::montgomery)
+            __kernels::mont_mul<words_num>(res,x,montgomery_r2.data(),modulus.data(),montgomery_p_inv);
+        else
+            std::copy(x,x+words_num,res);
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    void _mod_uint<N,Modulus>::from_repr(uint16_t *res, const uint16_t *x)
+    {
+        if constexpr(reduction == _mod_reduction::montgomery)
+        {
+            uint16_t wide[2*words_num] = {};
+            std::copy(x,x+words_num,wide);
+            __kernels::mont_reduce<words_num>(res,wide,modulus.data(),montgomery_p_inv);
+        }
+        else
+            std::copy(x,x+words_num,res);
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus>::_mod_uint() : repr(0) {}
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus>::_mod_uint(uint64_t value) : _mod_uint<N,Modulus>(_uint<64>(value)) {}
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus>::_mod_uint(const std::string_view hex_str) : _mod_uint<N,Modulus>(_uint<N>(hex_str)) {}
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    template<uint32_t M, uint32_t M_significant>
+    _mod_uint<N,Modulus>::_mod_uint(const _uint_view<M,M_significant>& x) : repr(0)
+    {
+        _uint<N> p(0);
+        std::copy(modulus.begin(),modulus.end(),p.value);
+        _uint<M,M_significant> r = x % p;
+        std::copy(r.value,r.value+std::min(words_num,_uint_view<M,M_significant>::significant_words_num),repr.value);
+        to_repr(repr.value,repr.value);
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus>::_mod_uint(const _mod_uint<N,Modulus>& x) : repr(x.repr) {}
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus>::_mod_uint(_mod_uint<N,Modulus>&& x) : repr(std::move(x.repr)) {}
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus>& _mod_uint<N,Modulus>::operator=(const _mod_uint<N,Modulus>& x)
+    {
+        repr = x.repr;
+        return *this;
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _uint<N> _mod_uint<N,Modulus>::value() const
+    {
+        _uint<N> res;
+        from_repr(res.value,repr.value);
+        return res;
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus>::operator std::string() const
+    {
+        return value();
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus>& _mod_uint<N,Modulus>::operator+=(const _mod_uint<N,Modulus>& other)
+    {
+        uint16_t carry = __kernels::add_n<words_num>(repr.value,repr.value,other.repr.value);
+        __kernels::reduce_once<words_num>(repr.value,repr.value,carry,modulus.data());
+        return *this;
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus>& _mod_uint<N,Modulus>::operator-=(const _mod_uint<N,Modulus>& other)
+    {
+        uint16_t borrow = __kernels::sub_n<words_num>(repr.value,repr.value,other.repr.value);
+        uint16_t masked_p[words_num];
+        __globals::unroll<words_num>([&](auto i) { masked_p[i] = modulus[i] & -borrow; });
+        __kernels::add_n<words_num>(repr.value,repr.value,masked_p);
+        return *this;
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus>& _mod_uint<N,Modulus>::operator*=(const _mod_uint<N,Modulus>& other)
+    {
+        if constexpr(reduction == _mod_reduction::montgomery)
+            __kernels::mont_mul<words_num>(repr.value,repr.value,other.repr.value,modulus.data(),montgomery_p_inv);
+        else
+        {
+            uint16_t wide[2*words_num];
+            __kernels::mul_n<words_num>(wide,repr.value,other.repr.value);
+            reduce(repr.value,wide);
+        }
+        return *this;
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus> _mod_uint<N,Modulus>::operator+(const _mod_uint<N,Modulus>& other) const
+    {
+        _mod_uint<N,Modulus> res(*this);
+        return res += other;
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus> _mod_uint<N,Modulus>::operator-(const _mod_uint<N,Modulus>& other) const
+    {
+        _mod_uint<N,Modulus> res(*this);
+        return res -= other;
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus> _mod_uint<N,Modulus>::operator*(const _mod_uint<N,Modulus>& other) const
+    {
+        _mod_uint<N,Modulus> res(*this);
+        return res *= other;
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus> _mod_uint<N,Modulus>::square() const
+    {
+        _mod_uint<N,Modulus> res;
+        uint16_t wide[2*words_num];
+        __kernels::sqr_n<words_num>(wide,repr.value);
+        reduce(res.repr.value,wide);
+        return res;
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    _mod_uint<N,Modulus> _mod_uint<N,Modulus>::inverse() const
+    {
+        _uint<N> p(0);
+        std::copy(modulus.begin(),modulus.end(),p.value);
+        _mod_uint<N,Modulus> res;
+        if constexpr(modulus[0] & 1)
+            res.repr = mod_inverse_ct(value(),p);
+        else
+            res.repr = mod_inverse(value(),p).value_or(_uint<N>(0));
+        to_repr(res.repr.value,res.repr.value);
+        return res;
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+        requires(N >= 16 and __globals::is_power_2(N))
+    bool _mod_uint<N,Modulus>::operator==(const _mod_uint<N,Modulus>& other) const
+    {
+        return repr == other.repr;
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+    std::ostream& operator<<(std::ostream& out, const _mod_uint<N,Modulus>& x)
+    {
+        out << (std::string)x;
+        return out;
+    }
+
+
+    template<uint32_t N, __globals::hex_literal Modulus>
+    std::istream& operator>>(std::istream& in, _mod_uint<N,Modulus>& x)
+    {
+        std::string hex;
+        in >> hex;
+        x = _mod_uint<N,Modulus>(hex);
+
+        return in;
+    }
+}
+
+#endif
@@ -0,0 +1,277 @@
+#ifndef LRF_ROOT_HPP
+#define LRF_ROOT_HPP
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "uint.hpp"
+
+namespace lrf
+{
+    namespace __kernels
+    {
+        // Bit r is set iff r is a square modulo m, m <= 64.
+        constexpr uint64_t quadratic_residues(uint32_t m)
+        {
+            uint64_t res = 0;
+            for(uint32_t i(0); i < m; ++i)
+                res |= uint64_t(1) << (i*i % m);
+            return res;
+        }
+
+
+        // Odd primes whose product fits in 32 bits, used to reject non-squares before isqrt.
+        constexpr std::array<uint32_t,9> square_filter_primes = {3,5,7,11,13,17,19,23,29};
+        constexpr uint64_t square_filter_modulus = 3ull*5*7*11*13*17*19*23*29;
+        constexpr std::array<uint64_t,9> square_filter_residues = []()
+        {
+            std::array<uint64_t,9> res{};
+            for(uint32_t i(0); i < res.size(); ++i)
+                res[i] = quadratic_residues(square_filter_primes[i]);
+            return res;
+        }();
+
+
+        inline uint64_t isqrt_word(uint64_t a)
+        {
+            uint64_t r = std::sqrt((double)a);
+            while(r > a/std::max<uint64_t>(r,1))
+                --r;
+            while(r+1 <= a/(r+1))
+                ++r;
+            return r;
+        }
+
+
+        // r^k > a, without overflowing.
+        inline bool pow_word_exceeds(uint64_t r, uint32_t k, uint64_t a)
+        {
+            uint64_t res = 1;
+            for(uint32_t i(0); i < k; ++i)
+            {
+                if(r and res > a/r)
+                    return true;
+                res *= r;
+            }
+            return false;
+        }
+
+
+        inline uint64_t iroot_word(uint64_t a, uint32_t k)
+        {
+            uint64_t r = std::pow((double)a,1.0/k);
+            while(pow_word_exceeds(r,k,a))
+                --r;
+            while(!pow_word_exceeds(r+1,k,a))
+                ++r;
+            return r;
+        }
+
+
+        // a mod m for m < 2^32.
+        inline uint64_t mod_word(const uint16_t *a, uint32_t n, uint64_t m)
+        {
+            uint64_t rem = 0;
+            for(uint32_t i(n); i-- > 0;)
+                rem = ((rem << word_bits) | a[i]) % m;
+            return rem;
+        }
+
+
+        // res = x[0..xn)^e, e >= 1, in e*bit_length(x)/16+2 words.
+        inline void pow(__instrumentation::counted_vector<uint16_t>& res, const uint16_t *x, uint32_t xn, uint32_t e)
+        {
+            // One word more than the power needs, as products of significant sizes can exceed it by one
+            res.resize(uint64_t(e)*bit_length(x,xn)/word_bits+2);
+            __instrumentation::counted_vector<uint16_t> t(res.size());
+            std::fill(res.begin(),res.end(),0);
+            std::copy(x,x+xn,res.begin());
+            for(uint32_t i(std::bit_width(e)-1); i-- > 0;)
+            {
+                uint32_t rn = significant_size(res.data(),res.size());
+                std::fill(t.begin(),t.end(),0);
+                mul(t.data(),res.data(),rn,res.data(),rn);
+                res.swap(t);
+                if(e >> i & 1)
+                {
+                    rn = significant_size(res.data(),res.size());
+                    std::fill(t.begin(),t.end(),0);
+                    mul(t.data(),res.data(),rn,x,xn);
+                    res.swap(t);
+                }
+            }
+        }
+
+
+        // res[0..(n+1)/2) = floor(sqrt(a[0..n))).
+        // Newton's iteration with precision doubling (the recurrence of CPython's math.isqrt):
+        // step s takes x ~ sqrt(a >> 2(c-e)) with e bits to d ~ 2e bits, dividing a 2d bit prefix
+        // of a by x. The steps grow geometrically, so the whole root costs about two divisions of
+        // a by a half-size operand. The result of the last step is off by at most one.
+        inline void isqrt(uint16_t *res, const uint16_t *a, uint32_t n)
+        {
+            uint32_t rn = (n+1)/2;
+            std::fill(res,res+rn,0);
+            uint32_t a_bits = bit_length(a,n);
+            if(a_bits <= 64)
+            {
+                uint64_t r = isqrt_word(extract_bits(a,n,0));
+                for(uint32_t i(0); i < rn and r; ++i, r >>= word_bits)
+                    res[i] = r & word_mask;
+                return;
+            }
+
+            uint32_t c = (a_bits-1)/2;
+            __instrumentation::counted_vector<uint16_t> x(rn+1,0), t(n), q(n), scratch(n+rn+2);
+            x[0] = 1;
+            uint32_t d = 0;
+            for(uint32_t s(std::bit_width(c)); s-- > 0;)
+            {
+                uint32_t e = d;
+                d = c >> s;
+                // x = (x << (d-e-1)) + (a >> (2c-e-d+1)) / x
+                shift_right(t.data(),a,n,2*c-e-d+1);
+                uint32_t tn = significant_size(t.data(),n);
+                divmod(q.data(),nullptr,t.data(),tn,x.data(),significant_size(x.data(),rn+1),scratch.data());
+                shift_left(x.data(),x.data(),rn+1,d-e-1);
+                add_inplace(x.data(),rn+1,q.data(),significant_size(q.data(),tn));
+            }
+
+            uint32_t xn = significant_size(x.data(),rn+1);
+            __instrumentation::counted_vector<uint16_t> square(2*xn);
+            mul(square.data(),x.data(),xn,x.data(),xn);
+            if(compare(square.data(),2*xn,a,n) > 0)
+            {
+                uint16_t one = 1;
+                sub_inplace(x.data(),rn+1,&one,1);
+            }
+            std::copy(x.begin(),x.begin()+rn,res);
+        }
+
+
+        // floor((a >> k(h-p))^(1/k)) for h = ceil(bit_length(a)/k), i.e. the top p bits of the
+        // k-th root of a. Recurses on p/2 bits, so every Newton run starts from an overestimate
+        // accurate to about half its bits and finishes in one or two steps plus the step that
+        // detects convergence.
+        inline __instrumentation::counted_vector<uint16_t> iroot_prefix(const uint16_t *a, uint32_t n, uint32_t k, uint32_t h, uint32_t p)
+        {
+            __instrumentation::counted_vector<uint16_t> x(p/word_bits+2,0);
+            if(p == 1 or uint64_t(k)*p <= 64)
+            {
+                // a >> k(h-p) has at most kp bits
+                uint64_t r = p == 1 ? 1 : iroot_word(extract_bits(a,n,k*(h-p)),k);
+                for(uint32_t i(0); r; ++i, r >>= word_bits)
+                    x[i] = r & word_mask;
+                return x;
+            }
+
+            // root < (prefix+1) << (p-p_half)
+            uint32_t p_half = (p+1)/2;
+            __instrumentation::counted_vector<uint16_t> prefix = iroot_prefix(a,n,k,h,p_half);
+            uint16_t one = 1;
+            add_inplace(prefix.data(),prefix.size(),&one,1);
+            std::copy(prefix.begin(),prefix.end(),x.begin());
+            shift_left(x.data(),x.data(),x.size(),p-p_half);
+
+            __instrumentation::counted_vector<uint16_t> np(n);
+            shift_right(np.data(),a,n,k*(h-p));
+            uint32_t npn = significant_size(np.data(),n);
+            const uint16_t k_words[2] = {uint16_t(k & word_mask),uint16_t(k >> word_bits)};
+            const uint16_t k1_words[2] = {uint16_t((k-1) & word_mask),uint16_t((k-1) >> word_bits)};
+            // For short roots np/x^(k-1) can be much larger than x
+            __instrumentation::counted_vector<uint16_t> y(std::max<uint32_t>(x.size(),npn)+3), q(npn), power, quotient(y.size()), scratch(2*y.size()+1);
+            // y = ((k-1)x + np/x^(k-1)) / k, until it stops decreasing
+            while(true)
+            {
+                uint32_t xn = significant_size(x.data(),x.size());
+                pow(power,x.data(),xn,k-1);
+                uint32_t pn = significant_size(power.data(),power.size());
+                std::fill(q.begin(),q.end(),0);
+                if(pn <= npn)
+                    divmod(q.data(),nullptr,np.data(),npn,power.data(),pn);
+                std::fill(y.begin(),y.end(),0);
+                mul(y.data(),x.data(),xn,k1_words,2);
+                add_inplace(y.data(),y.size(),q.data(),npn);
+                divmod(quotient.data(),nullptr,y.data(),y.size(),k_words,2,scratch.data());
+                if(compare(quotient.data(),quotient.size(),x.data(),x.size()) >= 0)
+                    return x;
+                std::copy(quotient.begin(),quotient.begin()+x.size(),x.begin());
+            }
+        }
+
+
+        // res[0..n) = floor(a[0..n)^(1/k)), k >= 2.
+        inline void iroot(uint16_t *res, const uint16_t *a, uint32_t n, uint32_t k)
+        {
+            std::fill(res,res+n,0);
+            uint32_t a_bits = bit_length(a,n);
+            if(a_bits == 0)
+                return;
+            if(k == 2)
+            {
+                isqrt(res,a,n);
+                return;
+            }
+            uint32_t h = (a_bits+k-1)/k;
+            __instrumentation::counted_vector<uint16_t> x = iroot_prefix(a,n,k,h,h);
+            uint32_t xn = std::min<uint32_t>(significant_size(x.data(),x.size()),n);
+            std::copy(x.begin(),x.begin()+xn,res);
+        }
+
+
+        // Rejects about 99.9% of non-squares with a few word divisions, then compares isqrt(a)^2.
+        inline bool is_perfect_square(const uint16_t *a, uint32_t n)
+        {
+            constexpr uint64_t residues_64 = quadratic_residues(64);
+            if(!(residues_64 >> (a[0] & 63) & 1))
+                return false;
+            uint64_t r = mod_word(a,n,square_filter_modulus);
+            for(uint32_t i(0); i < square_filter_primes.size(); ++i)
+                if(!(square_filter_residues[i] >> (r % square_filter_primes[i]) & 1))
+                    return false;
+
+            uint32_t rn = (n+1)/2;
+            __instrumentation::counted_vector<uint16_t> root(rn), square(2*rn);
+            isqrt(root.data(),a,n);
+            mul(square.data(),root.data(),rn,root.data(),rn);
+            return compare(square.data(),2*rn,a,n) == 0;
+        }
+    }
+
+
+    // floor(sqrt(a))
+    template<uint32_t N, uint32_t N_significant>
+    _uint<N,N_significant> isqrt(const _uint_view<N,N_significant>& a)
+    {
+        constexpr uint32_t n = _uint_view<N,N_significant>::significant_words_num;
+        _uint<N,N_significant> res(0);
+        __kernels::isqrt(res.value,a.value,n);
+        return res;
+    }
+
+
+    // floor(a^(1/k)). Throws std::domain_error for k = 0.
+    template<uint32_t N, uint32_t N_significant>
+    _uint<N,N_significant> iroot(const _uint_view<N,N_significant>& a, uint32_t k)
+    {
+        constexpr uint32_t n = _uint_view<N,N_significant>::significant_words_num;
+        if(k == 0)
+            throw std::domain_error("zeroth root");
+        _uint<N,N_significant> res(0);
+        if(k == 1)
+            std::copy(a.value,a.value+n,res.value);
+        else
+            __kernels::iroot(res.value,a.value,n,k);
+        return res;
+    }
+
+
+    template<uint32_t N, uint32_t N_significant>
+    bool is_perfect_square(const _uint_view<N,N_significant>& a)
+    {
+        return __kernels::is_perfect_square(a.value,_uint_view<N,N_significant>::significant_words_num);
+    }
+}
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef LRF_THREAD_POOL_HPP
+#define LRF_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lrf
+{
+    // Fixed set of worker threads running parallel loops. Every participant (the workers and the
+    // calling thread) owns a contiguous slice of the index range and takes grains from its front;
+    // once its slice is exhausted it steals grains from the other slices. Slices are claimed with
+    // a single fetch_add, so there is no shared queue to contend on.
+    class _thread_pool
+    {
+        struct alignas(64) slice
+        {
+            std::atomic<std::size_t> next;
+            std::size_t end;
+        };
+
+        std::vector<std::thread> workers;
+        std::unique_ptr<slice[]> slices;
+
+        std::mutex submit_mutex;
+        std::mutex state_mutex;
+        std::condition_variable job_ready;
+        std::condition_variable job_done;
+        uint64_t generation = 0;
+        uint32_t active_workers = 0;
+        bool stopping = false;
+
+        const std::function<void(std::size_t,std::size_t)> *job = nullptr;
+        std::size_t job_grain = 1;
+        std::exception_ptr job_error;
+
+        static bool& inside_job()
+        {
+            thread_local bool inside = false;
+            return inside;
+        }
+
+        uint32_t participants_num() const { return workers.size()+1; }
+
+        void run_slices(uint32_t self)
+        {
+            bool& inside = inside_job();
+            inside = true;
+            try
+            {
+                for(uint32_t k(0); k < participants_num(); ++k)
+                {
+                    slice& s = slices[(self+k) % participants_num()];
+                    for(std::size_t begin = s.next.fetch_add(job_grain,std::memory_order_relaxed); begin < s.end;
+                        begin = s.next.fetch_add(job_grain,std::memory_order_relaxed))
+                        (*job)(begin,std::min(begin+job_grain,s.end));
+                }
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                if(!job_error)
+                    job_error = std::current_exception();
+            }
+            inside = false;
+        }
+
+        void worker_loop(uint32_t self)
+        {
+            uint64_t seen_generation = 0;
+            while(true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(state_mutex);
+                    job_ready.wait(lock,[&]() { return stopping or generation != seen_generation; });
+                    if(stopping)
+                        return;
+                    seen_generation = generation;
+                }
+                run_slices(self);
+                std::lock_guard<std::mutex> lock(state_mutex);
+                if(--active_workers == 0)
+                    job_done.notify_one();
+            }
+        }
+
+    public:
+        // threads_num counts the calling thread, which takes part in every loop.
+        explicit _thread_pool(uint32_t threads_num = std::max(1u,std::thread::hardware_concurrency()))
+            : slices(new slice[std::max(1u,threads_num)])
+        {
+            for(uint32_t i(1); i < threads_num; ++i)
+                workers.emplace_back(&_thread_pool::worker_loop,this,i);
+        }
+
+        _thread_pool(const _thread_pool&) = delete;
+        _thread_pool& operator=(const _thread_pool&) = delete;
+
+        ~_thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                stopping = true;
+            }
+            job_ready.notify_all();
+            for(std::thread& worker : workers)
+                worker.join();
+        }
+
+        uint32_t size() const { return participants_num(); }
+
+        // Calls f(begin,end) over disjoint ranges covering [0,n), at most grain indices each, and
+        // returns once all of them are done. The first exception thrown by f is rethrown here.
+        // Loops started from inside a job run on the calling thread only.
+        void parallel_for(std::size_t n, const std::function<void(std::size_t,std::size_t)>& f, std::size_t grain = 1)
+        {
+            grain = std::max<std::size_t>(grain,1);
+            if(n == 0)
+                return;
+            if(workers.empty() or n <= grain or inside_job())
+            {
+                for(std::size_t begin(0); begin < n; begin += grain)
+                    f(begin,std::min(begin+grain,n));
+                return;
+            }
+
+            std::lock_guard<std::mutex> submit_lock(submit_mutex);
+            {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                for(uint32_t i(0); i < participants_num(); ++i)
+                {
+                    slices[i].next.store(n*i/participants_num(),std::memory_order_relaxed);
+                    slices[i].end = n*(i+1)/participants_num();
+                }
+                job = &f;
+                job_grain = grain;
+                job_error = nullptr;
+                active_workers = workers.size();
+                ++generation;
+            }
+            job_ready.notify_all();
+            run_slices(0);
+            std::unique_lock<std::mutex> lock(state_mutex);
+            job_done.wait(lock,[&]() { return active_workers == 0; });
+            job = nullptr;
+            if(job_error)
+                std::rethrow_exception(job_error);
+        }
+
+        // Pool shared by the batch functions unless one is passed explicitly.
+        static _thread_pool& global()
+        {
+            static _thread_pool pool;
+            return pool;
+        }
+    };
+}
+
+#endif
@@ -9,7 +9,12 @@
 #include <iomanip>
 #include <iostream>
 #include <algorithm>
+#include <compare>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
 #include "globals.hpp"
+#include "kernels.hpp"
 
 namespace lrf
 {
@@ -42,6 +47,10 @@ namespace lrf
 
     // ===END TYPEDEFS===
 
+    // _uint or _uint_view of any width, for functions taking spans of operands
+    template<typename T>
+    concept _uint_like = std::derived_from<T,_uint_view<T::words_num*T::word_bits,T::significant_words_num*T::word_bits>>;
+
     template<uint32_t N, uint32_t N_significant>
         requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
     class _uint_view
@@ -106,8 +115,23 @@ namespace lrf
         _uint_mul_out_t<N,N_significant,M,M_significant>
         operator*(const _uint_view<M,M_significant>& other) const requires (N >= __globals::karatsuba_bound);
 
+        template<uint32_t M, uint32_t M_significant>
+        _uint<N,N_significant>
+        operator/(const _uint_view<M,M_significant>& other) const;
+
+        template<uint32_t M, uint32_t M_significant>
+        _uint<N,N_significant>
+        operator%(const _uint_view<M,M_significant>& other) const;
+
+        _uint<N> operator<<(uint32_t shift) const;
+
+        _uint<N,N_significant> operator>>(uint32_t shift) const;
+
         template<uint32_t M, uint32_t M_significant>
         bool operator==(const _uint_view<M,M_significant>& x) const;
+
+        template<uint32_t M, uint32_t M_significant>
+        std::strong_ordering operator<=>(const _uint_view<M,M_significant>& x) const;
     };
 
 
@@ -138,7 +162,10 @@ namespace lrf
 
     template<uint32_t N, uint32_t N_significant>
         requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
-    _uint<N,N_significant>::_uint() : _uint_view<N,N_significant>(new typename _uint<N,N_significant>::word_type[_uint<N,N_significant>::words_num]) {}
+    _uint<N,N_significant>::_uint() : _uint_view<N,N_significant>(new typename _uint<N,N_significant>::word_type[_uint<N,N_significant>::words_num])
+    {
+        LRF_COUNT_ALLOCATION((_uint<N,N_significant>::words_num*sizeof(typename _uint<N,N_significant>::word_type)));
+    }
 
 
     template<uint32_t N, uint32_t N_significant>
@@ -203,6 +230,7 @@ namespace lrf
         requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
     _uint<N,N_significant>::_uint(const _uint_view<N,N_significant>& x) : _uint<N,N_significant>()
     {
+        LRF_COUNT_OP(copy);
         std::copy(x.value,x.value+_uint<N,N_significant>::words_num,this->value);
     }
 
@@ -211,13 +239,17 @@ namespace lrf
         requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
     _uint<N,N_significant>::_uint(const _uint<N,N_significant>& x) : _uint<N,N_significant>()
     {
+        LRF_COUNT_OP(copy);
         std::copy(x.value,x.value+_uint<N,N_significant>::words_num,this->value);
     }
 
 
     template<uint32_t N, uint32_t N_significant>
         requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
-    _uint<N,N_significant>::_uint(_uint<N,N_significant>&& x) : _uint_view<N,N_significant>(std::forward<_uint<N,N_significant>>(x)) {}
+    _uint<N,N_significant>::_uint(_uint<N,N_significant>&& x) : _uint_view<N,N_significant>(std::forward<_uint<N,N_significant>>(x))
+    {
+        LRF_COUNT_OP(move);
+    }
 
 
     template<uint32_t N, uint32_t N_significant>
@@ -232,6 +264,7 @@ namespace lrf
         requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
     _uint<N,N_significant>& _uint<N,N_significant>::operator=(const _uint<N,N_significant>& x)
     {
+        LRF_COUNT_OP(assign);
         std::copy(x.value,x.value+_uint<N,N_significant>::words_num,this->value);
         return *this;
     }
@@ -242,6 +275,7 @@ namespace lrf
     template<uint32_t M, uint32_t M_significant>
     _uint<N,N_significant>& _uint<N,N_significant>::operator=(const _uint_view<M,M_significant>& x)
     {
+        LRF_COUNT_OP(assign);
         constexpr uint32_t min_significant_size = std::min(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
         std::copy(x.value,x.value+min_significant_size,this->value);
         std::fill(this->value+min_significant_size,this->value+_uint<N,N_significant>::words_num,0);
@@ -249,6 +283,15 @@ namespace lrf
     }
 
 
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    template<uint32_t M, uint32_t M_significant>
+    _uint<N,N_significant>::operator _uint<M,M_significant>() const
+    {
+        return _uint_view<N,N_significant>::operator _uint<M,M_significant>();
+    }
+
+
     template<uint32_t N, uint32_t N_significant>
         requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
     _uint_view<N,N_significant>::_uint_view(const _uint_view<N,N_significant>& x)
@@ -300,6 +343,7 @@ namespace lrf
     template<uint32_t M, uint32_t M_significant>
     _uint_view<N,N_significant>::operator _uint<M,M_significant>() const
     {
+        LRF_COUNT_OP(convert);
         _uint<M,M_significant> res;
         constexpr uint32_t min_significant_bits = std::min(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
         for(uint32_t i(0); i < min_significant_bits; ++i)
@@ -310,7 +354,7 @@ namespace lrf
     }
 
 
-    std::string ltrim(const std::string &s)
+    inline std::string ltrim(const std::string &s)
     {
         size_t start = s.find_first_not_of("0");
         return (start == std::string::npos) ? "0" : s.substr(start);
@@ -341,7 +385,7 @@ namespace lrf
     template<uint32_t M, uint32_t M_significant>
     bool _uint_view<N,N_significant>::operator==(const _uint_view<M,M_significant>& x) const
     {
-        bool res = false;
+        LRF_COUNT_OP(compare);
         uint32_t min_size = std::min(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
         bool common_part_is_equal = std::equal(this->value,this->value+min_size,x.value);
         bool none_after_common_1 = std::none_of(this->value+min_size,this->value+_uint<N,N_significant>::significant_words_num,[](uint16_t arg) { return arg; });
@@ -350,6 +394,16 @@ namespace lrf
     }
 
 
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    template<uint32_t M, uint32_t M_significant>
+    std::strong_ordering _uint_view<N,N_significant>::operator<=>(const _uint_view<M,M_significant>& x) const
+    {
+        LRF_COUNT_OP(compare);
+        return __kernels::compare(this->value,_uint<N,N_significant>::significant_words_num,x.value,_uint<M,M_significant>::significant_words_num) <=> 0;
+    }
+
+
     template<uint32_t N, uint32_t N_significant>
         requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
     _uint_view<N,N_significant>& _uint_view<N,N_significant>::operator=(const _uint_view<N,N_significant>& x)
@@ -374,23 +428,30 @@ namespace lrf
     template<uint32_t M, uint32_t M_significant>
     _uint_view<N,N_significant>& _uint_view<N,N_significant>::operator+=(const _uint_view<M,M_significant>& b) requires(N_significant == N)
     {
-        uint16_t r = 0;
-        constexpr uint32_t significant_ops = std::min(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
-        for(uint32_t i = 0; i < significant_ops; ++i)
+        LRF_COUNT_OP(add);
+        if constexpr(N <= __globals::unrolled_kernels_bound and M <= __globals::unrolled_kernels_bound)
         {
-            uint32_t word_sum = (uint32_t)this->value[i] + (uint32_t)b.value[i] + (uint32_t)r;
-            this->value[i] = word_sum & uint16_t(0xffff);
-            r = word_sum >> _uint<N,N_significant>::word_bits;
+            __kernels::add_n<_uint<N>::words_num,_uint<M,M_significant>::significant_words_num,_uint<N>::words_num>(this->value,this->value,b.value);
         }
-        for(uint32_t i = significant_ops; i < _uint<N,N_significant>::words_num; ++i)
+        else
         {
-            if(r == 0)
-                break;
-            uint32_t word_sum = (uint32_t)this->value[i] + (uint32_t)r;
-            this->value[i] = word_sum & uint16_t(0xffff);
-            r = word_sum >> _uint<N,N_significant>::word_bits;
+            uint16_t r = 0;
+            constexpr uint32_t significant_ops = std::min(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
+            for(uint32_t i = 0; i < significant_ops; ++i)
+            {
+                uint32_t word_sum = (uint32_t)this->value[i] + (uint32_t)b.value[i] + (uint32_t)r;
+                this->value[i] = word_sum & uint16_t(0xffff);
+                r = word_sum >> _uint<N,N_significant>::word_bits;
+            }
+            for(uint32_t i = significant_ops; i < _uint<N,N_significant>::words_num; ++i)
+            {
+                if(r == 0)
+                    break;
+                uint32_t word_sum = (uint32_t)this->value[i] + (uint32_t)r;
+                this->value[i] = word_sum & uint16_t(0xffff);
+                r = word_sum >> _uint<N,N_significant>::word_bits;
+            }
         }
-
         return *this;
     }
 
@@ -400,24 +461,31 @@ namespace lrf
     template<uint32_t M, uint32_t M_significant>
     _uint_view<N,N_significant>& _uint_view<N,N_significant>::operator-=(const _uint_view<M,M_significant>& b) requires(N_significant == N)
     {
-        uint16_t r = 0;
-        constexpr uint32_t significant_ops = std::min(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
-        for(uint32_t i(0); i < significant_ops; ++i)
+        LRF_COUNT_OP(sub);
+        if constexpr(N <= __globals::unrolled_kernels_bound and M <= __globals::unrolled_kernels_bound)
         {
-            uint32_t sub_total = (uint32_t)b.value[i] + (uint32_t)r;
-            r = sub_total > this->value[i] ? 1 : 0;
-            this->value[i] = ((uint32_t)(r ? _uint_view<N,N_significant>::base : 0) - (uint32_t)sub_total) + (uint32_t)this->value[i];
+            __kernels::sub_n<_uint<N>::words_num,_uint<M,M_significant>::significant_words_num,_uint<N>::words_num>(this->value,this->value,b.value);
         }
-        uint32_t i = significant_ops;
-        for(; i < _uint_view<N>::words_num; ++i)
+        else
         {
-            if(r == 0)
-                break;
-            uint32_t sub_total = (uint32_t)r;
-            r = sub_total > this->value[i] ? 1 : 0;
-            this->value[i] = ((uint32_t)(r ? _uint_view<N,N_significant>::base : 0) - (uint32_t)sub_total) + (uint32_t)this->value[i];
+            uint16_t r = 0;
+            constexpr uint32_t significant_ops = std::min(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
+            for(uint32_t i(0); i < significant_ops; ++i)
+            {
+                uint32_t sub_total = (uint32_t)b.value[i] + (uint32_t)r;
+                r = sub_total > this->value[i] ? 1 : 0;
+                this->value[i] = ((uint32_t)(r ? _uint_view<N,N_significant>::base : 0) - (uint32_t)sub_total) + (uint32_t)this->value[i];
+            }
+            uint32_t i = significant_ops;
+            for(; i < _uint_view<N>::words_num; ++i)
+            {
+                if(r == 0)
+                    break;
+                uint32_t sub_total = (uint32_t)r;
+                r = sub_total > this->value[i] ? 1 : 0;
+                this->value[i] = ((uint32_t)(r ? _uint_view<N,N_significant>::base : 0) - (uint32_t)sub_total) + (uint32_t)this->value[i];
+            }
         }
-
         return *this;
     }
 
@@ -427,26 +495,21 @@ namespace lrf
     template<uint32_t M, uint32_t M_significant>
     _uint_view<N,N_significant>& _uint_view<N,N_significant>::operator*=(const _uint_view<M,M_significant>& b) requires(N < __globals::karatsuba_bound and N_significant == N)
     {
-        uint64_t pseudo_res[_uint<N*2,N_significant*2>::words_num];
-        pseudo_res[_uint<2*N,2*N_significant>::words_num-1] = 0;
-        std::fill(pseudo_res,pseudo_res+_uint<N*2,N_significant*2>::words_num,0);
-        constexpr uint32_t significant_ops = std::min(_uint<2*N,2*N_significant>::words_num,
-                                            _uint<2*N,2*N_significant>::significant_words_num+_uint<2*M,2*M_significant>::significant_words_num);
-        for(uint32_t i(0); i < significant_ops-1; ++i)
+        LRF_COUNT_OP(mul);
+        if constexpr(N <= __globals::unrolled_kernels_bound and M <= __globals::unrolled_kernels_bound)
         {
-            uint32_t lower_bound = i >= _uint_view<N>::words_num ? i-_uint_view<N>::words_num+1 : 0;
-            uint32_t upper_bound = std::min(i,_uint_view<N>::words_num-1);
-            for(uint32_t j(lower_bound); j <= upper_bound; ++j)
-            {
-                uint32_t a_v = this->value[j];
-                uint32_t b_v = b.value[upper_bound-j+lower_bound];
-                pseudo_res[i] += a_v*b_v;
-            }
+            LRF_COUNT_MUL_TIER(unrolled);
+            uint16_t res[_uint<N>::words_num];
+            __kernels::mul_n<_uint<N>::words_num,_uint<M,M_significant>::significant_words_num,_uint<N>::words_num>(res,this->value,b.value);
+            std::copy(res,res+_uint<N>::words_num,this->value);
+        }
+        else
+        {
+            LRF_COUNT_MUL_TIER(schoolbook);
+            uint16_t res[_uint<N>::words_num];
+            __kernels::mul_blocked(res,this->value,_uint<N>::words_num,b.value,_uint<M,M_significant>::significant_words_num,_uint<N>::words_num);
+            std::copy(res,res+_uint<N>::words_num,this->value);
         }
-        for(uint32_t i(1); i < significant_ops; ++i)
-            pseudo_res[i] += pseudo_res[i-1] >> 16;
-        for(uint32_t i(0); i < _uint_view<N*2>::words_num; ++i)
-            this->value[i] = pseudo_res[i] & uint16_t(0xffff);
         return *this;
     }
 
@@ -456,6 +519,8 @@ namespace lrf
     template<uint32_t M, uint32_t M_significant>
     _uint_view<N,N_significant>& _uint_view<N,N_significant>::operator*=(const _uint_view<M,M_significant>& b) requires(N >= __globals::karatsuba_bound and N_significant == N)
     {
+        LRF_COUNT_OP(mul);
+        LRF_COUNT_MUL_TIER(karatsuba);
         const _uint_view<N/2> a_lower_half(const_cast<_uint_view<N>::word_type*>(this->template get_part_view<2,0>()));
         const _uint_view<N/2> a_upper_half(const_cast<_uint_view<N>::word_type*>(this->template get_part_view<2,_uint_view<N>::words_num/2>()));
         const _uint_view<N/2> b_lower_half(const_cast<_uint_view<N>::word_type*>(b.template get_part_view<2,0>()));
@@ -477,32 +542,40 @@ namespace lrf
     template<uint32_t M, uint32_t M_significant>
     _uint_add_out_t<N,N_significant,M,M_significant> _uint_view<N,N_significant>::operator+(const _uint_view<M,M_significant>& other) const
     {
+        LRF_COUNT_OP(add);
         _uint_add_out_t<N,N_significant,M,M_significant> res;
-        constexpr uint32_t significant_ops_min = std::min(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
-        constexpr uint32_t significant_ops_max = std::max(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
-        uint16_t r = 0;
-        for(uint32_t i = 0; i < significant_ops_min; ++i)
+        if constexpr(N <= __globals::unrolled_kernels_bound and M <= __globals::unrolled_kernels_bound)
         {
-            uint32_t word_sum = (uint32_t)this->value[i] + (uint32_t)other.value[i] + (uint32_t)r;
-            res.value[i] = word_sum & uint16_t(0xffff);
-            r = word_sum >> _uint<N,N_significant>::word_bits;
+            __kernels::add_n<_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num,
+                             _uint_add_out_t<N,N_significant,M,M_significant>::words_num>(res.value,this->value,other.value);
         }
-        for(uint32_t i = significant_ops_min; i < significant_ops_max; ++i)
+        else
         {
-            uint32_t word_sum = r;
-            if constexpr(_uint<N,N_significant>::significant_words_num > significant_ops_min)
-                word_sum += (uint32_t)this->value[i];
-            else
-                word_sum += (uint32_t)other.value[i];
-            res.value[i] = word_sum & uint16_t(0xffff);
-            r = word_sum >> _uint<N,N_significant>::word_bits;
-        }
-        if constexpr(significant_ops_max < _uint_add_out_t<N,N_significant,M,M_significant>::words_num)
-        {
-            res.value[significant_ops_max] = r;
-            std::fill(res.value+significant_ops_max+1,res.value+_uint_add_out_t<N,N_significant,M,M_significant>::words_num,0);
+            constexpr uint32_t significant_ops_min = std::min(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
+            constexpr uint32_t significant_ops_max = std::max(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
+            uint16_t r = 0;
+            for(uint32_t i = 0; i < significant_ops_min; ++i)
+            {
+                uint32_t word_sum = (uint32_t)this->value[i] + (uint32_t)other.value[i] + (uint32_t)r;
+                res.value[i] = word_sum & uint16_t(0xffff);
+                r = word_sum >> _uint<N,N_significant>::word_bits;
+            }
+            for(uint32_t i = significant_ops_min; i < significant_ops_max; ++i)
+            {
+                uint32_t word_sum = r;
+                if constexpr(_uint<N,N_significant>::significant_words_num > significant_ops_min)
+                    word_sum += (uint32_t)this->value[i];
+                else
+                    word_sum += (uint32_t)other.value[i];
+                res.value[i] = word_sum & uint16_t(0xffff);
+                r = word_sum >> _uint<N,N_significant>::word_bits;
+            }
+            if constexpr(significant_ops_max < _uint_add_out_t<N,N_significant,M,M_significant>::words_num)
+            {
+                res.value[significant_ops_max] = r;
+                std::fill(res.value+significant_ops_max+1,res.value+_uint_add_out_t<N,N_significant,M,M_significant>::words_num,0);
+            }
         }
-
         return res;
     }
 
@@ -512,29 +585,36 @@ namespace lrf
     template<uint32_t M, uint32_t M_significant>
     _uint_sub_out_t<N,N_significant,M,M_significant> _uint_view<N,N_significant>::operator-(const _uint_view<M,M_significant>& other) const
     {
+        LRF_COUNT_OP(sub);
         _uint_sub_out_t<N,N_significant,M,M_significant> res;
-        constexpr uint32_t significant_ops_min = std::min(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
-        constexpr uint32_t significant_ops_max = std::max(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
-        uint16_t r = 0;
-        for(uint32_t i(0); i < significant_ops_min; ++i)
+        if constexpr(N <= __globals::unrolled_kernels_bound and M <= __globals::unrolled_kernels_bound)
         {
-            uint32_t sub_total = (uint32_t)other.value[i] + (uint32_t)r;
-            r = sub_total > this->value[i] ? 1 : 0;
-            res.value[i] = ((uint32_t)(r ? _uint_view<N,N_significant>::base : 0) - (uint32_t)sub_total) + (uint32_t)this->value[i];
+            __kernels::sub_n<_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num,
+                             _uint_sub_out_t<N,N_significant,M,M_significant>::words_num>(res.value,this->value,other.value);
         }
-        for(uint32_t i = significant_ops_min; i < significant_ops_max; ++i)
+        else
         {
-            uint32_t sub_total = r;
-            if constexpr(_uint<M,M_significant>::significant_words_num > significant_ops_min)
-                sub_total += (uint32_t)other.value[i];
-            r = sub_total > this->value[i] ? 1 : 0;
-            uint32_t sub_val = ((uint32_t)(r ? _uint_view<N,N_significant>::base : 0) - (uint32_t)sub_total);
-            if constexpr(_uint<N,N_significant>::significant_words_num > significant_ops_min)
-                sub_val += (uint32_t)this->value[i];
-            res.value[i] = sub_val;
+            constexpr uint32_t significant_ops_min = std::min(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
+            constexpr uint32_t significant_ops_max = std::max(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
+            uint16_t r = 0;
+            for(uint32_t i(0); i < significant_ops_min; ++i)
+            {
+                uint32_t sub_total = (uint32_t)other.value[i] + (uint32_t)r;
+                r = sub_total > this->value[i] ? 1 : 0;
+                res.value[i] = ((uint32_t)(r ? _uint_view<N,N_significant>::base : 0) - (uint32_t)sub_total) + (uint32_t)this->value[i];
+            }
+            for(uint32_t i = significant_ops_min; i < significant_ops_max; ++i)
+            {
+                uint32_t sub_total = r, minuend = 0;
+                if constexpr(_uint<M,M_significant>::significant_words_num > significant_ops_min)
+                    sub_total += (uint32_t)other.value[i];
+                if constexpr(_uint<N,N_significant>::significant_words_num > significant_ops_min)
+                    minuend = this->value[i];
+                r = sub_total > minuend ? 1 : 0;
+                res.value[i] = ((uint32_t)(r ? _uint_view<N,N_significant>::base : 0) - sub_total) + minuend;
+            }
+            std::fill(res.value+significant_ops_max,res.value+_uint_sub_out_t<N,N_significant,M,M_significant>::words_num,(uint32_t)0x10000-r);
         }
-        std::fill(res.value+significant_ops_max,res.value+_uint_sub_out_t<N,N_significant,M,M_significant>::words_num,(uint32_t)0x10000-r);
-
         return res;
     }
 
@@ -544,25 +624,22 @@ namespace lrf
     template<uint32_t M, uint32_t M_significant>
     _uint_mul_out_t<N,N_significant,M,M_significant> _uint_view<N,N_significant>::operator*(const _uint_view<M,M_significant>& other) const requires (N < __globals::karatsuba_bound)
     {
+        LRF_COUNT_OP(mul);
         _uint_mul_out_t<N,N_significant,M,M_significant> res;
-        uint64_t pseudo_res[_uint_mul_out_t<N,N_significant,M,M_significant>::words_num];
-        constexpr uint32_t significant_ops = std::min(_uint_mul_out_t<N,N_significant,M,M_significant>::words_num,
-                                            _uint<N,N_significant>::significant_words_num+_uint<M,M_significant>::significant_words_num);
-        std::fill(pseudo_res,pseudo_res+significant_ops,0ULL);
-        for(uint32_t i(0); i < _uint<N,N_significant>::significant_words_num; ++i)
+        if constexpr(N <= __globals::unrolled_kernels_bound and M <= __globals::unrolled_kernels_bound)
         {
-            for(uint32_t j(0); j < std::min(_uint<M,M_significant>::significant_words_num,_uint_mul_out_t<N,N_significant,M,M_significant>::words_num-i); ++j)
-            {
-                uint32_t a_v = this->value[i];
-                uint32_t b_v = other.value[j];
-                pseudo_res[i+j] += a_v*b_v;
-            }
+            LRF_COUNT_MUL_TIER(unrolled);
+            __kernels::mul_n<_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num,
+                             _uint_mul_out_t<N,N_significant,M,M_significant>::words_num>(res.value,this->value,other.value);
+        }
+        else
+        {
+            LRF_COUNT_MUL_TIER(schoolbook);
+            constexpr uint32_t significant_ops = std::min(_uint_mul_out_t<N,N_significant,M,M_significant>::words_num,
+                                                _uint<N,N_significant>::significant_words_num+_uint<M,M_significant>::significant_words_num);
+            __kernels::mul_blocked(res.value,this->value,_uint<N,N_significant>::significant_words_num,other.value,_uint<M,M_significant>::significant_words_num,significant_ops);
+            std::fill(res.value+significant_ops,res.value+_uint_mul_out_t<N,N_significant,M,M_significant>::words_num,0);
         }
-
-        for(uint32_t i(1); i < _uint_mul_out_t<N,N_significant,M,M_significant>::words_num; ++i)
-            pseudo_res[i] += pseudo_res[i-1] >> 16;
-        for(uint32_t i(0); i < significant_ops; ++i)
-            res.value[i] = pseudo_res[i] & uint16_t(0xffff);
         return res;
     }
 
@@ -572,6 +649,8 @@ namespace lrf
     template<uint32_t M, uint32_t M_significant>
     _uint_mul_out_t<N,N_significant,M,M_significant> _uint_view<N,N_significant>::operator*(const _uint_view<M,M_significant>& other) const requires (N >= __globals::karatsuba_bound)
     {
+        LRF_COUNT_OP(mul);
+        LRF_COUNT_MUL_TIER(karatsuba);
         _uint<N*2> res(0);
         const _uint_view<N/2> a_lower_half(const_cast<_uint_view<N>::word_type*>(this->template get_part_view<2,0>()));
         const _uint_view<N/2> a_upper_half(const_cast<_uint_view<N>::word_type*>(this->template get_part_view<2,_uint_view<N/2>::words_num>()));
@@ -580,19 +659,70 @@ namespace lrf
         _uint<N> z_0 = a_lower_half * b_lower_half;
         _uint<N> z_2 = a_upper_half * b_upper_half;
         _uint<N> z_1 = (a_lower_half + a_upper_half)*(b_lower_half + b_upper_half) - z_0 - z_2;
-        std::cout << "z0: " << z_0 << '\n';
-        std::cout << "z1: " << z_1 << '\n';
-        std::cout << "z2: " << z_2 << '\n';
         _uint_view<N> quoter_0(res.template get_part_view<2,0>());
         _uint_view<N> quoter_1(res.template get_part_view<2,_uint_view<N/2>::words_num>());
         _uint_view<N> quoter_2(res.template get_part_view<2,_uint_view<N>::words_num>());
-        std::cout << "r0: " << res << '\n';
         quoter_0 += z_0;
-        std::cout << "r1: " << res << '\n';
         quoter_1 += z_1;
-        std::cout << "r2: " << res << '\n';
         quoter_2 += z_2;
-        std::cout << "r3: " << res << '\n';
+        return res;
+    }
+
+
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    template<uint32_t M, uint32_t M_significant>
+    _uint<N,N_significant> _uint_view<N,N_significant>::operator/(const _uint_view<M,M_significant>& other) const
+    {
+        LRF_COUNT_OP(div);
+        if(__kernels::significant_size(other.value,_uint<M,M_significant>::significant_words_num) == 0)
+            throw std::domain_error("division by zero");
+        _uint<N,N_significant> res;
+        __kernels::divmod(res.value,nullptr,this->value,_uint<N,N_significant>::significant_words_num,other.value,_uint<M,M_significant>::significant_words_num);
+        std::fill(res.value+_uint<N,N_significant>::significant_words_num,res.value+_uint<N,N_significant>::words_num,0);
+        return res;
+    }
+
+
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    template<uint32_t M, uint32_t M_significant>
+    _uint<N,N_significant> _uint_view<N,N_significant>::operator%(const _uint_view<M,M_significant>& other) const
+    {
+        LRF_COUNT_OP(mod);
+        if(__kernels::significant_size(other.value,_uint<M,M_significant>::significant_words_num) == 0)
+            throw std::domain_error("division by zero");
+        _uint<N,N_significant> res;
+        uint16_t rem[_uint<M,M_significant>::significant_words_num];
+        constexpr uint32_t min_significant_size = std::min(_uint<N,N_significant>::significant_words_num,_uint<M,M_significant>::significant_words_num);
+        __kernels::divmod(nullptr,rem,this->value,_uint<N,N_significant>::significant_words_num,other.value,_uint<M,M_significant>::significant_words_num);
+        std::copy(rem,rem+min_significant_size,res.value);
+        std::fill(res.value+min_significant_size,res.value+_uint<N,N_significant>::words_num,0);
+        return res;
+    }
+
+
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    _uint<N> _uint_view<N,N_significant>::operator<<(uint32_t shift) const
+    {
+        LRF_COUNT_OP(shift_left);
+        _uint<N> res;
+        std::copy(this->value,this->value+_uint<N,N_significant>::significant_words_num,res.value);
+        std::fill(res.value+_uint<N,N_significant>::significant_words_num,res.value+_uint<N>::words_num,0);
+        __kernels::shift_left(res.value,res.value,_uint<N>::words_num,shift);
+        return res;
+    }
+
+
+    template<uint32_t N, uint32_t N_significant>
+        requires(N >= 16 and __globals::is_power_2(N) and N_significant <= N and N_significant % 16 == 0)
+    _uint<N,N_significant> _uint_view<N,N_significant>::operator>>(uint32_t shift) const
+    {
+        LRF_COUNT_OP(shift_right);
+        _uint<N,N_significant> res;
+        __kernels::shift_right(res.value,this->value,_uint<N,N_significant>::significant_words_num,shift);
+        std::fill(res.value+_uint<N,N_significant>::significant_words_num,res.value+_uint<N,N_significant>::words_num,0);
         return res;
     }
 
@@ -614,6 +744,27 @@ namespace lrf
 
         return in;
     }
+
+
+    // Hash of the value, equal for all _uint and _uint_view that compare equal, whatever their
+    // widths. Transparent, so a container keyed by one width can be searched with another
+    // (together with std::equal_to<>).
+    struct _uint_hash
+    {
+        typedef void is_transparent;
+
+        template<uint32_t N, uint32_t N_significant>
+        std::size_t operator()(const _uint_view<N,N_significant>& x) const noexcept
+        {
+            return __kernels::hash(x.value,_uint_view<N,N_significant>::significant_words_num);
+        }
+    };
 }
 
+template<uint32_t N, uint32_t N_significant>
+struct std::hash<lrf::_uint_view<N,N_significant>> : lrf::_uint_hash {};
+
+template<uint32_t N, uint32_t N_significant>
+struct std::hash<lrf::_uint<N,N_significant>> : lrf::_uint_hash {};
+
 #endif
\ No newline at end of file
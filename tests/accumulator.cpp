@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include "accumulator.hpp"
+
+
+TEST(accumulator_test,sum_1024_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::ifstream fin_samples(test_cases_dir+"uint1024_256_samples.txt");
+    ASSERT_TRUE(fin_samples.is_open());
+    lrf::_uint_accumulator<1024> acc;
+    lrf::uint1024_t sum(0);
+    while(!fin_samples.eof())
+    {
+        lrf::_uint<1024,256> a,b;
+        fin_samples >> a >> b;
+        if(fin_samples.eof()) break;
+        acc.add(a);
+        acc.add(b);
+        sum += a;
+        sum += b;
+    }
+    ASSERT_EQ(sum,acc.finalize());
+}
+
+
+TEST(accumulator_test,dot_product_1024_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::ifstream fin_samples(test_cases_dir+"uint1024_256_samples.txt");
+    ASSERT_TRUE(fin_samples.is_open());
+    lrf::_uint_accumulator<1024> acc;
+    lrf::uint1024_t dot(0);
+    uint32_t i = 0;
+    while(!fin_samples.eof())
+    {
+        lrf::_uint<1024,256> a,b;
+        fin_samples >> a >> b;
+        if(fin_samples.eof()) break;
+        acc.add_product(a,b);
+        dot += a*b;
+        if(++i % 1000 == 0)
+        {
+            acc.normalize();
+            ASSERT_EQ(dot,acc.finalize());
+        }
+    }
+    ASSERT_EQ(dot,acc.finalize());
+}
+
+
+TEST(accumulator_test,truncated_product_test)
+{
+    // Products wider than the accumulator wrap modulo 2^N like operator*.
+    lrf::uint512_t a("ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+    lrf::uint256_t b("123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef0");
+    lrf::_uint_accumulator<512> acc;
+    lrf::uint512_t expected(0);
+    for(uint32_t i(0); i < 100; ++i)
+    {
+        acc.add_product(a,b);
+        acc.add_product(b,a);
+        acc.add(a);
+        expected += a*(lrf::uint512_t)b;
+        expected += a*(lrf::uint512_t)b;
+        expected += a;
+    }
+    ASSERT_EQ(expected,acc.finalize());
+    acc.reset();
+    ASSERT_EQ(lrf::uint512_t(0),acc.finalize());
+}
+
+
+TEST(accumulator_test,automatic_normalization_test)
+{
+    // Every all-ones product raises the limb bound by 16*0xffff^2 ~ 2^36, so 2^13 products
+    // cross the minimal capacity of 2^48 and normalize() runs inside add_product().
+    lrf::uint256_t ones("ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+    lrf::_uint_accumulator<256> acc(lrf::_uint_accumulator<256>::min_limb_capacity);
+    lrf::uint256_t expected(0), square = ones*ones;
+    for(uint32_t i(0); i < (1u << 13); ++i)
+    {
+        acc.add_product(ones,ones);
+        acc.add(ones);
+        expected += square;
+        expected += ones;
+    }
+    ASSERT_EQ(expected,acc.finalize());
+}
+
+
+TEST(accumulator_test,capacity_range_test)
+{
+    typedef lrf::_uint_accumulator<256> accumulator_t;
+    ASSERT_THROW(accumulator_t(accumulator_t::min_limb_capacity-1),std::invalid_argument);
+    ASSERT_THROW(accumulator_t(accumulator_t::max_limb_capacity+1),std::invalid_argument);
+}
+
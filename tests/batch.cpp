@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <vector>
+#include "batch.hpp"
+
+
+template<typename A, typename B>
+void read_samples(const std::string& file_name, std::vector<A>& a, std::vector<B>& b)
+{
+    std::ifstream fin_samples(file_name);
+    ASSERT_TRUE(fin_samples.is_open());
+    while(!fin_samples.eof())
+    {
+        A x;
+        B y;
+        fin_samples >> x >> y;
+        if(fin_samples.eof()) break;
+        a.push_back(x);
+        b.push_back(y);
+    }
+}
+
+
+template<typename R>
+void check_results(const std::string& file_name, const std::vector<R>& res)
+{
+    std::ifstream fin_res(file_name);
+    ASSERT_TRUE(fin_res.is_open());
+    for(const R& x : res)
+    {
+        R res_actual;
+        fin_res >> res_actual;
+        ASSERT_EQ(res_actual,x);
+    }
+}
+
+
+TEST(batch_test,batch_512_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::vector<lrf::uint512_t> a,b;
+    read_samples(test_cases_dir+"uint512_samples.txt",a,b);
+    std::vector<lrf::uint512_t> res(a.size());
+    lrf::_thread_pool pool(4);
+
+    lrf::multiply_batch(std::span<const lrf::uint512_t>(a),std::span<const lrf::uint512_t>(b),std::span<lrf::uint512_t>(res),pool);
+    check_results(test_cases_dir+"uint512_mul.txt",res);
+    lrf::add_batch(std::span<const lrf::uint512_t>(a),std::span<const lrf::uint512_t>(b),std::span<lrf::uint512_t>(res),pool);
+    check_results(test_cases_dir+"uint512_add.txt",res);
+    lrf::subtract_batch(std::span<const lrf::uint512_t>(a),std::span<const lrf::uint512_t>(b),std::span<lrf::uint512_t>(res),pool);
+    check_results(test_cases_dir+"uint512_sub.txt",res);
+}
+
+
+TEST(batch_test,batch_1024_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::vector<lrf::uint1024_t> a;
+    std::vector<lrf::_uint<1024,256>> b;
+    read_samples(test_cases_dir+"uint1024_256_samples.txt",a,b);
+    std::vector<lrf::uint1024_t> res(a.size());
+    lrf::_thread_pool pool(3);
+
+    lrf::multiply_batch(std::span<const lrf::uint1024_t>(a),std::span<const lrf::_uint<1024,256>>(b),std::span<lrf::uint1024_t>(res),pool);
+    check_results(test_cases_dir+"uint1024_256_mul.txt",res);
+    lrf::add_batch(std::span<const lrf::uint1024_t>(a),std::span<const lrf::_uint<1024,256>>(b),std::span<lrf::uint1024_t>(res),pool);
+    check_results(test_cases_dir+"uint1024_256_add.txt",res);
+}
+
+
+TEST(batch_test,narrow_significant_output_test)
+{
+    typedef lrf::_uint<512,256> out_t;
+    std::vector<lrf::uint256_t> a(2,lrf::uint256_t(0)), b(2,lrf::uint256_t(1));
+    a[1] = lrf::uint256_t(0) - lrf::uint256_t(1);
+    std::vector<out_t> res(2,out_t(0));
+    lrf::add_batch(std::span<const lrf::uint256_t>(a),std::span<const lrf::uint256_t>(b),std::span<out_t>(res));
+    // a[1]+1 wraps at the 256 significant bits of out_t, not at 512
+    ASSERT_EQ(lrf::uint512_t(1),res[0]);
+    ASSERT_EQ(lrf::uint512_t(0),res[1]);
+    lrf::subtract_batch(std::span<const lrf::uint256_t>(a),std::span<const lrf::uint256_t>(b),std::span<out_t>(res));
+    ASSERT_EQ(a[1],res[0]);
+    ASSERT_EQ(a[1]-lrf::uint256_t(1),res[1]);
+}
+
+
+TEST(batch_test,multiply_batch_views_test)
+{
+    // Results written through views into a caller owned buffer, widened to the full product
+    std::vector<lrf::uint1024_t> a, b;
+    for(uint32_t i(0); i < 100; ++i)
+    {
+        a.push_back(lrf::uint1024_t(i+1) << 1000);
+        b.push_back(lrf::uint1024_t(i+2) << 900);
+    }
+    std::vector<uint16_t> buffer(a.size()*lrf::uint2048_t::words_num);
+    std::vector<lrf::_uint_view<2048>> res;
+    for(uint32_t i(0); i < a.size(); ++i)
+        res.push_back(lrf::_uint_view<2048>(buffer.data()+i*lrf::uint2048_t::words_num));
+    lrf::multiply_batch(std::span<const lrf::uint1024_t>(a),std::span<const lrf::uint1024_t>(b),std::span<lrf::_uint_view<2048>>(res));
+    for(uint32_t i(0); i < a.size(); ++i)
+        ASSERT_EQ(lrf::uint2048_t((i+1)*(i+2)) << 1900,res[i]);
+}
+
+
+TEST(batch_test,modexp_batch_512_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::vector<lrf::uint512_t> base,exp;
+    read_samples(test_cases_dir+"uint512_modexp_batch_samples.txt",base,exp);
+    lrf::uint512_t odd_modulus("bbb38c9196a33c9c36e71475feed8547ed91e6f75d94ed034576484326d515865cef51b381a10e47c35d760ae00ee53e09904bfe6bef5adacfb1ba8ec8ad79eb");
+    lrf::uint512_t even_modulus("614063e19ef31af6439e0f0d9a38947569920027af36cb88f4b01aebb814d40c4cfa7b97cf8e842ebacc5a5140eaf849b6dcbebfedf7bae254f85999e04a68");
+    std::vector<lrf::uint512_t> odd_res(base.size()), even_res(base.size());
+    lrf::_thread_pool pool(4);
+    lrf::modexp_batch(std::span<const lrf::uint512_t>(base),std::span<const lrf::uint512_t>(exp),odd_modulus,std::span<lrf::uint512_t>(odd_res),pool);
+    lrf::modexp_batch(std::span<const lrf::uint512_t>(base),std::span<const lrf::uint512_t>(exp),even_modulus,std::span<lrf::uint512_t>(even_res),pool);
+    std::ifstream fin_res(test_cases_dir+"uint512_modexp_batch.txt");
+    ASSERT_TRUE(fin_res.is_open());
+    for(uint32_t i(0); i < base.size(); ++i)
+    {
+        lrf::uint512_t odd_res_actual,even_res_actual;
+        fin_res >> odd_res_actual >> even_res_actual;
+        ASSERT_EQ(odd_res_actual,odd_res[i]);
+        ASSERT_EQ(even_res_actual,even_res[i]);
+    }
+}
+
+
+TEST(batch_test,size_mismatch_test)
+{
+    std::vector<lrf::uint256_t> a(3,lrf::uint256_t(0)), b(2,lrf::uint256_t(0)), res(3,lrf::uint256_t(0));
+    ASSERT_THROW(lrf::add_batch(std::span<const lrf::uint256_t>(a),std::span<const lrf::uint256_t>(b),std::span<lrf::uint256_t>(res)),std::invalid_argument);
+}
+
+
+TEST(batch_test,thread_pool_test)
+{
+    lrf::_thread_pool pool(4);
+    std::vector<uint32_t> hits(10000,0);
+    pool.parallel_for(hits.size(),[&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t i(begin); i < end; ++i)
+            ++hits[i];
+    },7);
+    ASSERT_TRUE(std::all_of(hits.begin(),hits.end(),[](uint32_t x) { return x == 1; }));
+    ASSERT_THROW(pool.parallel_for(100,[](std::size_t, std::size_t) { throw std::runtime_error("job failed"); }),std::runtime_error);
+}
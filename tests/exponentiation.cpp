@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <vector>
+#include "exponentiation.hpp"
+
+
+TEST(exponentiation_test,modexp_1024_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint1024_modexp_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint1024_modexp.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    ASSERT_TRUE(fin_samples.is_open() and fin_res.is_open());
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint1024_t base,exp,m,res,res_actual;
+        fin_samples >> base >> exp >> m;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = lrf::modexp(base,exp,m);
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(exponentiation_test,modexp_mixed_widths_test)
+{
+    // 3^p = 3 mod p for the prime p = 2^127-1
+    lrf::uint128_t m("7fffffffffffffffffffffffffffffff");
+    lrf::uint256_t exp = m;
+    ASSERT_EQ(lrf::uint128_t(3),lrf::modexp(lrf::uint512_t(3),exp,m));
+    ASSERT_EQ(lrf::uint128_t(0),lrf::modexp(m,exp,m));
+}
+
+
+TEST(exponentiation_test,modexp_zero_modulus_test)
+{
+    lrf::uint256_t a(3),e(5),m(0);
+    ASSERT_THROW(lrf::modexp(a,e,m),std::domain_error);
+}
+
+
+static const lrf::uint512_t odd_modulus("bbb38c9196a33c9c36e71475feed8547ed91e6f75d94ed034576484326d515865cef51b381a10e47c35d760ae00ee53e09904bfe6bef5adacfb1ba8ec8ad79eb");
+static const lrf::uint512_t even_modulus("614063e19ef31af6439e0f0d9a38947569920027af36cb88f4b01aebb814d40c4cfa7b97cf8e842ebacc5a5140eaf849b6dcbebfedf7bae254f85999e04a68");
+
+
+static void read_modexp_batch_samples(std::vector<lrf::uint512_t>& base, std::vector<lrf::uint512_t>& exp)
+{
+    std::ifstream fin_samples(std::string(PROJECT_ROOT)+"/tests/cases/uint512_modexp_batch_samples.txt");
+    ASSERT_TRUE(fin_samples.is_open());
+    while(!fin_samples.eof())
+    {
+        lrf::uint512_t b,e;
+        fin_samples >> b >> e;
+        if(fin_samples.eof()) break;
+        base.push_back(b);
+        exp.push_back(e);
+    }
+}
+
+
+TEST(exponentiation_test,fixed_base_512_test)
+{
+    std::vector<lrf::uint512_t> base,exp;
+    read_modexp_batch_samples(base,exp);
+    ASSERT_FALSE(base.empty());
+    lrf::_fixed_base_modexp<512> odd_table(base[0],odd_modulus,512), even_table(base[0],even_modulus,512);
+    std::ifstream fin_res(std::string(PROJECT_ROOT)+"/tests/cases/uint512_fixed_base.txt");
+    ASSERT_TRUE(fin_res.is_open());
+    for(const lrf::uint512_t& e : exp)
+    {
+        lrf::uint512_t odd_res_actual,even_res_actual;
+        fin_res >> odd_res_actual >> even_res_actual;
+        ASSERT_EQ(odd_res_actual,odd_table.pow(e));
+        ASSERT_EQ(even_res_actual,even_table.pow(e));
+    }
+}
+
+
+TEST(exponentiation_test,fixed_base_short_exponent_test)
+{
+    // 3^p = 3 mod p for the prime p = 2^127-1, through a table sized for 200 bit exponents
+    lrf::uint128_t m("7fffffffffffffffffffffffffffffff");
+    lrf::_fixed_base_modexp<128> table(lrf::uint256_t(3),m,200);
+    ASSERT_EQ(lrf::uint128_t(3),table.pow(m));
+    ASSERT_EQ(lrf::uint128_t(1),table.pow(lrf::uint256_t(0)));
+    ASSERT_EQ(lrf::uint128_t(81),table.pow(lrf::_uint<64>(4)));
+    ASSERT_THROW(table.pow(lrf::uint256_t(1) << 200),std::invalid_argument);
+}
+
+
+TEST(exponentiation_test,multi_modexp_512_test)
+{
+    std::vector<lrf::uint512_t> base,exp;
+    read_modexp_batch_samples(base,exp);
+    ASSERT_GE(base.size(),200u);
+    std::ifstream fin_res(std::string(PROJECT_ROOT)+"/tests/cases/uint512_multi_modexp.txt");
+    ASSERT_TRUE(fin_res.is_open());
+    // Full exponents go through Straus' windows
+    ASSERT_EQ(0,lrf::_mod_context<512>::bucket_bits(200,512));
+    for(std::size_t k : {1,3,31,200})
+    {
+        lrf::uint512_t odd_res_actual,even_res_actual;
+        fin_res >> odd_res_actual >> even_res_actual;
+        std::span<const lrf::uint512_t> bases(base.data(),k), exps(exp.data(),k);
+        ASSERT_EQ(odd_res_actual,lrf::multi_modexp(bases,exps,odd_modulus));
+        ASSERT_EQ(even_res_actual,lrf::multi_modexp(bases,exps,even_modulus));
+    }
+    // Views of the low 64 bits of the exponents, where many bases go through Pippenger's buckets
+    ASSERT_EQ(0,lrf::_mod_context<512>::bucket_bits(31,64));
+    ASSERT_NE(0,lrf::_mod_context<512>::bucket_bits(200,64));
+    std::vector<lrf::_uint_view<512,64>> short_exp;
+    for(lrf::uint512_t& e : exp)
+        short_exp.push_back(lrf::_uint_view<512,64>(e.value));
+    for(std::size_t k : {31,200})
+    {
+        lrf::uint512_t odd_res_actual,even_res_actual;
+        fin_res >> odd_res_actual >> even_res_actual;
+        std::span<const lrf::uint512_t> bases(base.data(),k);
+        std::span<const lrf::_uint_view<512,64>> exps(short_exp.data(),k);
+        ASSERT_EQ(odd_res_actual,lrf::multi_modexp(bases,exps,odd_modulus));
+        ASSERT_EQ(even_res_actual,lrf::multi_modexp(bases,exps,even_modulus));
+    }
+}
+
+
+TEST(exponentiation_test,multi_modexp_edge_test)
+{
+    lrf::uint256_t m(1000003);
+    std::vector<lrf::uint256_t> base{lrf::uint256_t(2),lrf::uint256_t(5)};
+    std::vector<lrf::_uint<256,64>> exp{lrf::_uint<256,64>(0),lrf::_uint<256,64>(0)};
+    ASSERT_EQ(lrf::uint256_t(1),lrf::multi_modexp(std::span<const lrf::uint256_t>(base),std::span<const lrf::_uint<256,64>>(exp),m));
+    ASSERT_EQ(lrf::uint256_t(1),lrf::multi_modexp(std::span<const lrf::uint256_t>(),std::span<const lrf::_uint<256,64>>(),m));
+    exp.pop_back();
+    ASSERT_THROW(lrf::multi_modexp(std::span<const lrf::uint256_t>(base),std::span<const lrf::_uint<256,64>>(exp),m),std::invalid_argument);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include "gcd.hpp"
+
+
+TEST(gcd_test,gcd_1024_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint1024_gcd_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint1024_gcd.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    ASSERT_TRUE(fin_samples.is_open() and fin_res.is_open());
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint1024_t a,b,res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = lrf::gcd(a,b);
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(gcd_test,xgcd_1024_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint1024_gcd_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint1024_gcd.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    ASSERT_TRUE(fin_samples.is_open() and fin_res.is_open());
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint1024_t a,b,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        auto res = lrf::xgcd(a,b);
+        ASSERT_EQ(res_actual,res.gcd);
+        ASSERT_TRUE(res.x_negative != res.y_negative or (res.x == lrf::uint1024_t(0) or res.y == lrf::uint1024_t(0)));
+        // a*x + b*y = gcd with the negative term moved to the other side
+        lrf::uint2048_t ax = (lrf::uint2048_t)a * (lrf::uint2048_t)res.x;
+        lrf::uint2048_t by = (lrf::uint2048_t)b * (lrf::uint2048_t)res.y;
+        lrf::uint2048_t g = res.gcd;
+        if(res.x_negative)
+            ASSERT_EQ(by,ax+g);
+        else if(res.y_negative)
+            ASSERT_EQ(ax,by+g);
+        else
+            ASSERT_EQ(g,ax+by);
+    }
+}
+
+
+TEST(gcd_test,mod_inverse_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint256_mod_inverse_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint256_mod_inverse.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    ASSERT_TRUE(fin_samples.is_open() and fin_res.is_open());
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint256_t a,m,res_actual;
+        fin_samples >> a >> m;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        auto res = lrf::mod_inverse(a,m);
+        if(res)
+            ASSERT_EQ(res_actual,*res);
+        else
+            ASSERT_EQ(res_actual,lrf::uint256_t(0));
+    }
+}
+
+
+TEST(gcd_test,mod_inverse_ct_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint256_mod_inverse_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint256_mod_inverse.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    ASSERT_TRUE(fin_samples.is_open() and fin_res.is_open());
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint256_t a,m,res,res_actual;
+        fin_samples >> a >> m;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = lrf::mod_inverse_ct(a,m);
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(gcd_test,mod_inverse_ct_even_modulus_test)
+{
+    lrf::uint256_t a(3),m(10);
+    ASSERT_THROW(lrf::mod_inverse_ct(a,m),std::domain_error);
+}
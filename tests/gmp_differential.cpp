@@ -0,0 +1,321 @@
+// Differential check of the _uint operators against GMP's mpn layer, and a side by side
+// timing of both. Built as GMP_DIFFERENTIAL when CMake finds GMP.
+//
+//     GMP_DIFFERENTIAL [samples per type pair]
+//
+// Every sample draws two operands from a mix of random values and edge cases (zero, one,
+// all ones, single GMP limb, single word, powers of two, random length) and runs them through
+// every operator. Results are compared word for word, over the whole width of the result
+// type, with the exact mpn result reduced modulo 2^(result bits). Exits with 1 on mismatch.
+
+#include <gmp.h>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "uint.hpp"
+
+
+namespace
+{
+    constexpr uint32_t words_per_limb = sizeof(mp_limb_t)*8 / 16;
+    uint64_t mismatches = 0;
+
+
+    constexpr uint32_t limbs_num(uint32_t words) { return (words+words_per_limb-1)/words_per_limb; }
+
+
+    // The first words of x as mpn limbs, zero padded to limbs words
+    std::vector<mp_limb_t> to_limbs(const uint16_t *x, uint32_t words, uint32_t limbs)
+    {
+        std::vector<mp_limb_t> res(limbs,0);
+        for(uint32_t i(0); i < words and i/words_per_limb < limbs; ++i)
+            res[i/words_per_limb] |= mp_limb_t(x[i]) << (i%words_per_limb*16);
+        return res;
+    }
+
+
+    template<typename T>
+    std::vector<mp_limb_t> to_limbs(const T& x, uint32_t limbs = limbs_num(T::significant_words_num))
+    {
+        return to_limbs(x.value,T::significant_words_num,limbs);
+    }
+
+
+    mp_size_t normalized_size(const std::vector<mp_limb_t>& x, mp_size_t n)
+    {
+        while(n > 0 and x[n-1] == 0)
+            --n;
+        return n;
+    }
+
+
+    // Compares all words of res with ref modulo 2^(16*R::words_num)
+    template<typename R>
+    bool matches(const R& res, const std::vector<mp_limb_t>& ref)
+    {
+        for(uint32_t i(0); i < R::words_num; ++i)
+        {
+            uint32_t limb = i/words_per_limb;
+            uint16_t expected = limb < ref.size() ? (ref[limb] >> (i%words_per_limb*16)) & 0xffff : 0;
+            if(res.value[i] != expected)
+                return false;
+        }
+        return true;
+    }
+
+
+    template<typename A, typename B>
+    void report_mismatch(const std::string& op, const A& a, const B& b)
+    {
+        if(++mismatches <= 20)
+            std::cerr << "mismatch: " << op << " on _uint<" << A::words_num*16 << "," << A::significant_words_num*16 << "> "
+                      << (std::string)a << " and _uint<" << B::words_num*16 << "," << B::significant_words_num*16 << "> "
+                      << (std::string)b << '\n';
+    }
+
+
+    enum class operand_kind { random, random_length, zero, one, all_ones, single_limb, single_word, power_of_two, count };
+
+
+    template<typename T>
+    T random_operand(std::mt19937_64& gen)
+    {
+        constexpr uint32_t n = T::significant_words_num;
+        T res(0);
+        operand_kind kind = operand_kind(gen() % (uint32_t)operand_kind::count);
+        switch(kind)
+        {
+            case operand_kind::random:
+                for(uint32_t i(0); i < n; ++i)
+                    res.value[i] = gen();
+                break;
+            case operand_kind::random_length:
+                for(uint32_t i(0), len = gen() % n + 1; i < len; ++i)
+                    res.value[i] = gen();
+                break;
+            case operand_kind::zero:
+                break;
+            case operand_kind::one:
+                res.value[0] = 1;
+                break;
+            case operand_kind::all_ones:
+                std::fill(res.value,res.value+n,0xffff);
+                break;
+            case operand_kind::single_limb:
+                for(uint32_t i(0); i < std::min(n,words_per_limb); ++i)
+                    res.value[i] = gen();
+                break;
+            case operand_kind::single_word:
+                res.value[0] = gen();
+                break;
+            default:
+            {
+                uint32_t bit = gen() % (16*n);
+                res.value[bit/16] = uint16_t(1) << (bit%16);
+            }
+        }
+        return res;
+    }
+
+
+    template<typename A, typename B>
+    void check_pair(std::mt19937_64& gen, uint32_t samples)
+    {
+        constexpr uint32_t an = A::significant_words_num, bn = B::significant_words_num;
+        for(uint32_t sample(0); sample < samples; ++sample)
+        {
+            A a = random_operand<A>(gen);
+            B b = random_operand<B>(gen);
+            // Wide enough for any exact result, so the reference is only ever truncated by matches()
+            uint32_t limbs = limbs_num(std::max(A::words_num,B::words_num)) + limbs_num(an) + limbs_num(bn) + 1;
+            std::vector<mp_limb_t> al = to_limbs(a,limbs), bl = to_limbs(b,limbs), ref(limbs), rem(limbs);
+
+            mpn_add_n(ref.data(),al.data(),bl.data(),limbs);
+            if(!matches(a+b,ref))
+                report_mismatch("+",a,b);
+            mpn_sub_n(ref.data(),al.data(),bl.data(),limbs);
+            if(!matches(a-b,ref))
+                report_mismatch("-",a,b);
+
+            std::fill(ref.begin(),ref.end(),0);
+            std::vector<mp_limb_t> product(limbs_num(an)+limbs_num(bn));
+            mpn_mul(product.data(),al.data(),limbs_num(an),bl.data(),limbs_num(bn));
+            std::copy(product.begin(),product.end(),ref.begin());
+            if(!matches(a*b,ref))
+                report_mismatch("*",a,b);
+
+            if constexpr(requires { a += b; })
+            {
+                A c = a;
+                c += b;
+                mpn_add_n(ref.data(),al.data(),bl.data(),limbs);
+                if(!matches(c,ref))
+                    report_mismatch("+=",a,b);
+                c = a;
+                c -= b;
+                mpn_sub_n(ref.data(),al.data(),bl.data(),limbs);
+                if(!matches(c,ref))
+                    report_mismatch("-=",a,b);
+                c = a;
+                c *= b;
+                std::fill(ref.begin(),ref.end(),0);
+                std::copy(product.begin(),product.end(),ref.begin());
+                if(!matches(c,ref))
+                    report_mismatch("*=",a,b);
+            }
+
+            mp_size_t a_size = normalized_size(al,limbs), b_size = normalized_size(bl,limbs);
+            if(b_size > 0)
+            {
+                std::vector<mp_limb_t> q(limbs+1,0);
+                std::fill(rem.begin(),rem.end(),0);
+                if(a_size >= b_size)
+                    mpn_tdiv_qr(q.data(),rem.data(),0,al.data(),a_size,bl.data(),b_size);
+                else
+                    std::copy(al.begin(),al.end(),rem.begin());
+                if(!matches(a/b,q))
+                    report_mismatch("/",a,b);
+                if(!matches(a%b,rem))
+                    report_mismatch("%",a,b);
+            }
+            else
+            {
+                bool thrown = false;
+                try { (void)(a/b); } catch(const std::domain_error&) { thrown = true; }
+                if(!thrown)
+                    report_mismatch("/ by zero",a,b);
+            }
+
+            int cmp = mpn_cmp(al.data(),bl.data(),limbs);
+            if((a == b) != (cmp == 0) or (a <=> b) != (cmp <=> 0))
+                report_mismatch("<=>",a,b);
+
+            uint32_t shift = gen() % (A::words_num*16+1);
+            uint32_t limb_shift = shift/64, bit_shift = shift%64;
+            std::fill(ref.begin(),ref.end(),0);
+            std::copy(al.begin(),al.end()-limb_shift,ref.begin()+limb_shift);
+            if(bit_shift)
+                mpn_lshift(ref.data(),ref.data(),limbs,bit_shift);
+            if(!matches(a << shift,ref))
+                report_mismatch("<< "+std::to_string(shift),a,b);
+            std::fill(ref.begin(),ref.end(),0);
+            std::copy(al.begin()+std::min(limb_shift,limbs),al.end(),ref.begin());
+            if(bit_shift)
+                mpn_rshift(ref.data(),ref.data(),limbs,bit_shift);
+            if(!matches(a >> shift,ref))
+                report_mismatch(">> "+std::to_string(shift),a,b);
+
+            // Conversion to the other type truncates to its significant words
+            std::vector<mp_limb_t> converted = to_limbs(a.value,std::min(an,bn),limbs);
+            if(!matches((B)a,converted))
+                report_mismatch("conversion",a,b);
+
+            std::string digits(limbs*16+1,0), hex = "0";
+            if(a_size > 0)
+            {
+                std::vector<mp_limb_t> tmp(al);
+                digits.resize(mpn_get_str((unsigned char*)digits.data(),16,tmp.data(),a_size));
+                hex.clear();
+                for(unsigned char d : digits)
+                    hex += "0123456789abcdef"[d];
+            }
+            if((std::string)a != hex or !(A(hex) == a))
+                report_mismatch("string",a,b);
+        }
+    }
+
+
+    volatile uint16_t sink;
+
+    // Average time of one call to f over enough calls to fill ~20 ms
+    template<typename F>
+    double ns_per_call(F&& f)
+    {
+        typedef std::chrono::steady_clock clock;
+        f();
+        for(uint64_t reps(1);; reps *= 2)
+        {
+            auto start = clock::now();
+            for(uint64_t i(0); i < reps; ++i)
+                f();
+            double ns = std::chrono::duration<double,std::nano>(clock::now()-start).count();
+            if(ns > 2e7)
+                return ns/reps;
+        }
+    }
+
+
+    template<uint32_t N>
+    void time_width(std::mt19937_64& gen)
+    {
+        typedef lrf::_uint<N> T;
+        constexpr uint32_t n = T::words_num, limbs = limbs_num(n);
+        T a(0), b(0), half(0);
+        for(uint32_t i(0); i < n; ++i)
+        {
+            a.value[i] = gen();
+            b.value[i] = gen();
+        }
+        for(uint32_t i(0); i < n/2; ++i)
+            half.value[i] = gen();
+        half.value[n/2-1] |= 0x8000;
+        std::vector<mp_limb_t> al = to_limbs(a), bl = to_limbs(b), hl = to_limbs(half), rl(2*limbs), ql(limbs);
+
+        struct row { const char *op; double lrf_ns, mpn_ns; };
+        std::vector<row> rows = {
+            {"+",ns_per_call([&]() { sink = (a+b).value[0]; }),
+                 ns_per_call([&]() { mpn_add_n(rl.data(),al.data(),bl.data(),limbs); sink = rl[0]; })},
+            {"-",ns_per_call([&]() { sink = (a-b).value[0]; }),
+                 ns_per_call([&]() { mpn_sub_n(rl.data(),al.data(),bl.data(),limbs); sink = rl[0]; })},
+            // mpn has no public low half product, so its side computes all 2N bits
+            {"*",ns_per_call([&]() { sink = (a*b).value[0]; }),
+                 ns_per_call([&]() { mpn_mul_n(rl.data(),al.data(),bl.data(),limbs); sink = rl[0]; })},
+            {"/ (N by N/2)",ns_per_call([&]() { sink = (a/half).value[0]; }),
+                 ns_per_call([&]() { mpn_tdiv_qr(ql.data(),rl.data(),0,al.data(),limbs,hl.data(),limbs/2); sink = ql[0]; })},
+            {"% (N by N/2)",ns_per_call([&]() { sink = (a%half).value[0]; }),
+                 ns_per_call([&]() { mpn_tdiv_qr(ql.data(),rl.data(),0,al.data(),limbs,hl.data(),limbs/2); sink = rl[0]; })},
+            {"<< 77",ns_per_call([&]() { sink = (a << 77).value[1]; }),
+                 ns_per_call([&]() { rl[0] = 0; mpn_lshift(rl.data()+1,al.data(),limbs-1,13); sink = rl[1]; })},
+        };
+        for(const row& r : rows)
+            std::cout << std::setw(6) << N << "  " << std::left << std::setw(14) << r.op << std::right
+                      << std::setw(12) << std::fixed << std::setprecision(1) << r.lrf_ns
+                      << std::setw(12) << r.mpn_ns << std::setw(9) << std::setprecision(2) << r.lrf_ns/r.mpn_ns << '\n';
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    uint32_t samples = argc > 1 ? std::atoi(argv[1]) : 2000;
+    std::mt19937_64 gen(35);
+
+    check_pair<lrf::uint128_t,lrf::uint128_t>(gen,samples);
+    check_pair<lrf::uint256_t,lrf::uint256_t>(gen,samples);
+    check_pair<lrf::uint512_t,lrf::uint512_t>(gen,samples);
+    check_pair<lrf::uint1024_t,lrf::uint1024_t>(gen,samples);
+    check_pair<lrf::uint2048_t,lrf::uint2048_t>(gen,samples);
+    check_pair<lrf::uint4096_t,lrf::uint4096_t>(gen,samples/4);
+    check_pair<lrf::uint512_t,lrf::uint256_t>(gen,samples);
+    check_pair<lrf::uint256_t,lrf::uint1024_t>(gen,samples);
+    check_pair<lrf::uint1024_t,lrf::_uint<1024,256>>(gen,samples);
+    check_pair<lrf::_uint<512,256>,lrf::uint512_t>(gen,samples);
+    check_pair<lrf::_uint<2048,512>,lrf::_uint<1024,512>>(gen,samples);
+    check_pair<lrf::_uint<256,32>,lrf::_uint<128,16>>(gen,samples);
+    std::cout << "differential check: " << mismatches << " mismatches\n\n";
+
+    std::cout << " width  op                  _uint       mpn    ratio\n"
+              << "                            ns/op     ns/op\n";
+    time_width<128>(gen);
+    time_width<256>(gen);
+    time_width<512>(gen);
+    time_width<1024>(gen);
+    time_width<2048>(gen);
+    time_width<4096>(gen);
+    time_width<8192>(gen);
+    return mismatches ? 1 : 0;
+}
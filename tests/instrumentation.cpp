@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "accumulator.hpp"
+
+
+// Built twice: into TEST without LRF_INSTRUMENTATION and into TEST_INSTRUMENTATION with it.
+
+
+TEST(instrumentation_test,allocations_test)
+{
+    lrf::counters_reset();
+    lrf::uint256_t a(1), b(a);
+    lrf::uint512_t c = (lrf::uint512_t)a;
+    b = a;
+    lrf::_uint_counters counters = lrf::counters_snapshot();
+    if constexpr(!lrf::_uint_counters::enabled)
+    {
+        ASSERT_EQ(lrf::_uint_counters(),counters);
+        return;
+    }
+    ASSERT_EQ(3,counters.allocations);
+    ASSERT_EQ(2*32+64,counters.allocated_bytes);
+    ASSERT_EQ(1,counters[lrf::_uint_op::copy]);
+    ASSERT_EQ(1,counters[lrf::_uint_op::convert]);
+    ASSERT_EQ(1,counters[lrf::_uint_op::assign]);
+    lrf::counters_reset();
+    ASSERT_EQ(lrf::_uint_counters(),lrf::counters_snapshot());
+}
+
+
+TEST(instrumentation_test,scratch_allocations_test)
+{
+    lrf::uint256_t a("123456789abc"), b("10001");
+    lrf::counters_reset();
+    lrf::uint256_t q = a/b;
+    lrf::_uint_counters counters = lrf::counters_snapshot();
+    if constexpr(!lrf::_uint_counters::enabled)
+    {
+        ASSERT_EQ(lrf::_uint_counters(),counters);
+        return;
+    }
+    ASSERT_EQ(lrf::uint256_t("12344444"),q);
+    // The quotient and the un+vn+1 words of normalized operands of the long division
+    ASSERT_EQ(2,counters.allocations);
+    ASSERT_EQ(32+(3+2+1)*2,counters.allocated_bytes);
+
+    lrf::counters_reset();
+    lrf::_uint_accumulator<256> acc;
+    counters = lrf::counters_snapshot();
+    ASSERT_EQ(1,counters.allocations);
+    ASSERT_EQ(16*8,counters.allocated_bytes);
+}
+
+
+TEST(instrumentation_test,operators_test)
+{
+    lrf::uint1024_t a("123456789abcdef"), b(0x1234);
+    lrf::counters_reset();
+    a += b;
+    a -= b;
+    bool lower = b < a;
+    bool equal = a == b;
+    a = a/b;
+    a = a%b;
+    a = a << 3;
+    a = a >> 3;
+    lrf::_uint_counters counters = lrf::counters_snapshot();
+    if constexpr(!lrf::_uint_counters::enabled)
+    {
+        ASSERT_EQ(lrf::_uint_counters(),counters);
+        return;
+    }
+    ASSERT_TRUE(lower and !equal);
+    ASSERT_EQ(1,counters[lrf::_uint_op::add]);
+    ASSERT_EQ(1,counters[lrf::_uint_op::sub]);
+    ASSERT_EQ(2,counters[lrf::_uint_op::compare]);
+    ASSERT_EQ(1,counters[lrf::_uint_op::div]);
+    ASSERT_EQ(1,counters[lrf::_uint_op::mod]);
+    ASSERT_EQ(1,counters[lrf::_uint_op::shift_left]);
+    ASSERT_EQ(1,counters[lrf::_uint_op::shift_right]);
+}
+
+
+TEST(instrumentation_test,multiplication_test)
+{
+    lrf::uint256_t a(3), b(5);
+    lrf::uint1024_t c(3), d(5);
+    lrf::counters_reset();
+    lrf::uint256_t ab = a*b;
+    lrf::uint1024_t cd = c*d;
+    lrf::_uint_counters counters = lrf::counters_snapshot();
+    if constexpr(!lrf::_uint_counters::enabled)
+    {
+        ASSERT_EQ(lrf::_uint_counters(),counters);
+        return;
+    }
+    ASSERT_EQ(lrf::uint256_t(15),ab);
+    ASSERT_EQ(lrf::uint1024_t(15),cd);
+    ASSERT_EQ(2,counters[lrf::_uint_op::mul]);
+    ASSERT_EQ(1,counters[lrf::_mul_tier::unrolled]);
+    ASSERT_EQ(1,counters[lrf::_mul_tier::schoolbook]);
+    ASSERT_EQ(0,counters[lrf::_mul_tier::karatsuba]);
+    // Products are truncated to max(N,M) bits. The schoolbook tier multiplies 32 words of b at
+    // a time, so row i of the 1024 bit product computes 64-i products rounded up to 32.
+    ASSERT_EQ(16*17/2+32*64+32*32,counters.partial_products);
+
+    lrf::counters_reset();
+    lrf::_uint_accumulator<256> acc;
+    acc.add_product(a,b);
+    ASSERT_EQ(16*17/2,lrf::counters_snapshot().partial_products);
+}
+
+
+TEST(instrumentation_test,per_thread_test)
+{
+    lrf::counters_reset();
+    lrf::_uint_counters thread_counters;
+    std::thread worker([&thread_counters]()
+    {
+        lrf::uint256_t a(3), b(5);
+        lrf::uint256_t ab = a*b;
+        thread_counters = lrf::counters_snapshot();
+    });
+    worker.join();
+    ASSERT_EQ(lrf::_uint_counters(),lrf::counters_snapshot());
+    if constexpr(lrf::_uint_counters::enabled)
+    {
+        ASSERT_EQ(1,thread_counters[lrf::_uint_op::mul]);
+    }
+}
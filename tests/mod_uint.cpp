@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include "mod_uint.hpp"
+
+
+typedef lrf::_mod_uint<256,"346f7c9eab38cf45a7ad98a70a603e9e1"> odd_field_t;
+typedef lrf::_mod_uint<256,"8ad30288e74120ac1510bc09c512ee52d2324779614935b674"> even_field_t;
+
+static_assert(lrf::p256_field_t::reduction == lrf::_mod_reduction::montgomery);
+static_assert(lrf::secp256k1_field_t::reduction == lrf::_mod_reduction::pseudo_mersenne);
+static_assert(lrf::curve25519_field_t::reduction == lrf::_mod_reduction::pseudo_mersenne);
+static_assert(odd_field_t::reduction == lrf::_mod_reduction::montgomery);
+static_assert(even_field_t::reduction == lrf::_mod_reduction::barrett);
+// 2^16 - 15 in a single word
+typedef lrf::_mod_uint<16,"fff1"> word_field_t;
+static_assert(word_field_t::reduction == lrf::_mod_reduction::pseudo_mersenne);
+
+
+// Every line holds a, b, a+b, a-b, a*b, a^2 and a^-1 (0 if not invertible).
+template<typename Field>
+void check_field(const std::string& cases_file_name)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::ifstream fin(test_cases_dir+cases_file_name);
+    ASSERT_TRUE(fin.is_open());
+    while(!fin.eof())
+    {
+        Field a,b;
+        lrf::uint256_t sum,diff,prod,sqr,inv;
+        fin >> a >> b >> sum >> diff >> prod >> sqr >> inv;
+        if(fin.eof()) break;
+        ASSERT_EQ(sum,(a+b).value());
+        ASSERT_EQ(diff,(a-b).value());
+        ASSERT_EQ(prod,(a*b).value());
+        ASSERT_EQ(sqr,a.square().value());
+        ASSERT_EQ(sqr,(a*a).value());
+        ASSERT_EQ(inv,a.inverse().value());
+        Field c(a);
+        c *= b;
+        c -= a;
+        c += a;
+        ASSERT_EQ(a*b,c);
+    }
+}
+
+
+TEST(mod_uint_test,p256_test)
+{
+    check_field<lrf::p256_field_t>("p256_field.txt");
+}
+
+
+TEST(mod_uint_test,secp256k1_test)
+{
+    check_field<lrf::secp256k1_field_t>("secp256k1_field.txt");
+}
+
+
+TEST(mod_uint_test,curve25519_test)
+{
+    check_field<lrf::curve25519_field_t>("curve25519_field.txt");
+}
+
+
+TEST(mod_uint_test,montgomery_small_modulus_test)
+{
+    check_field<odd_field_t>("uint256_odd_field.txt");
+}
+
+
+TEST(mod_uint_test,barrett_test)
+{
+    check_field<even_field_t>("uint256_even_field.txt");
+}
+
+
+TEST(mod_uint_test,reduction_on_construction_test)
+{
+    lrf::uint256_t p("7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed");
+    lrf::uint256_t x("ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+    ASSERT_EQ(x%p,lrf::curve25519_field_t(x).value());
+    ASSERT_EQ(lrf::uint256_t(0),lrf::curve25519_field_t(p).value());
+    ASSERT_EQ(lrf::uint256_t(5),lrf::p256_field_t(5).value());
+}
+
+
+TEST(mod_uint_test,single_word_pseudo_mersenne_test)
+{
+    constexpr uint32_t p = 0xfff1;
+    for(uint32_t a(0); a < p; a += 97)
+        for(uint32_t b : {0u,1u,2u,a,0x8000u,p-2,p-1})
+        {
+            word_field_t x(a), y(b);
+            ASSERT_EQ(lrf::_uint<16>((a+b)%p),(x+y).value());
+            ASSERT_EQ(lrf::_uint<16>((a+p-b)%p),(x-y).value());
+            ASSERT_EQ(lrf::_uint<16>(uint64_t(a)*b%p),(x*y).value());
+            ASSERT_EQ(lrf::_uint<16>(uint64_t(a)*a%p),x.square().value());
+            x *= y;
+            ASSERT_EQ(lrf::_uint<16>(uint64_t(a)*b%p),x.value());
+        }
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include "root.hpp"
+
+
+TEST(root_test,iroot_1024_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint1024_root_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint1024_root.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    ASSERT_TRUE(fin_samples.is_open() and fin_res.is_open());
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint1024_t a,res,res_actual;
+        uint32_t k;
+        fin_samples >> a >> k;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = lrf::iroot(a,k);
+        ASSERT_EQ(res_actual,res);
+        if(k == 2)
+        {
+            ASSERT_EQ(res_actual,lrf::isqrt(a));
+        }
+    }
+}
+
+
+TEST(root_test,is_perfect_square_4096_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint4096_square_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint4096_square.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    ASSERT_TRUE(fin_samples.is_open() and fin_res.is_open());
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint4096_t a;
+        bool res_actual;
+        fin_samples >> a;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        ASSERT_EQ(res_actual,lrf::is_perfect_square(a));
+    }
+}
+
+
+TEST(root_test,root_edge_test)
+{
+    typedef lrf::_uint<512,128> uint512_128_t;
+    uint512_128_t a("ffffffffffffffffffffffffffffffff"), zero(0);
+    ASSERT_EQ(uint512_128_t("ffffffffffffffff"),lrf::isqrt(a));
+    ASSERT_EQ(a,lrf::iroot(a,1));
+    ASSERT_EQ(uint512_128_t(1),lrf::iroot(a,200));
+    ASSERT_EQ(zero,lrf::iroot(zero,7));
+    ASSERT_TRUE(lrf::is_perfect_square(lrf::uint256_t(0)));
+    ASSERT_TRUE(lrf::is_perfect_square(lrf::uint256_t(1) << 254));
+    ASSERT_FALSE(lrf::is_perfect_square(lrf::uint256_t(1) << 255));
+    ASSERT_THROW(lrf::iroot(a,0),std::domain_error);
+}
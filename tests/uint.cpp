@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <fstream>
+#include <unordered_map>
+#include <unordered_set>
 #include "uint.hpp"
 
 
@@ -191,6 +193,48 @@ TEST(uint_test,multiplication_1024_256_test)
     }
 }
 
+TEST(uint_test,multiplication_4096_2048_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint4096_2048_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint4096_2048_mul.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    ASSERT_TRUE(fin_samples.is_open() and fin_res.is_open());
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::_uint<4096,2048> a,b;
+        lrf::uint4096_t res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a*b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,inplace_multiplication_4096_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint4096_2048_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint4096_2048_inplace_mul.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    ASSERT_TRUE(fin_samples.is_open() and fin_res.is_open());
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint4096_t a,b,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        a *= b;
+        a *= b;
+        ASSERT_EQ(res_actual,a);
+    }
+}
+
+
 /*
 TEST(uint_test,multiplication_32768_test)
 {
@@ -210,3 +254,510 @@ TEST(uint_test,multiplication_32768_test)
     }
 }
 */
+
+
+TEST(uint_test,division_1024_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint1024_div_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint1024_div.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint1024_t a,b,res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a/b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,modulo_1024_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint1024_div_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint1024_mod.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint1024_t a,b,res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a%b;
+        ASSERT_EQ(res_actual,res);
+        ASSERT_TRUE(res < b);
+        ASSERT_EQ(a,(a/b)*b+res);
+    }
+}
+
+
+TEST(uint_test,shift_1024_test)
+{
+    lrf::uint1024_t a("8000000000000000000000000000000000000000000000000000000000000001");
+    ASSERT_EQ(lrf::uint1024_t("10000000000000000000000000000000000000000000000000000000000000002"),a << 1);
+    ASSERT_EQ(lrf::uint1024_t("4000000000000000000000000000000000000000000000000000000000000000"),a >> 1);
+    ASSERT_EQ(a,(a << 300) >> 300);
+    ASSERT_EQ(lrf::uint1024_t(0),a >> 256);
+    ASSERT_EQ(lrf::uint1024_t(0),a << 1024);
+    ASSERT_TRUE(a > (a >> 1) and (a >> 1) < a and a <= a);
+}
+
+
+TEST(uint_test,addition_128_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint128_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint128_add.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint128_t a,b,res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a+b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,subtraction_128_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint128_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint128_sub.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint128_t a,b,res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a-b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,multiplication_128_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint128_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint128_mul.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint128_t a,b,res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a*b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,inplace_addition_128_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint128_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint128_add.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint128_t a,b,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        a += b;
+        ASSERT_EQ(res_actual,a);
+    }
+}
+
+
+TEST(uint_test,inplace_subtraction_128_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint128_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint128_sub.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint128_t a,b,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        a -= b;
+        ASSERT_EQ(res_actual,a);
+    }
+}
+
+
+TEST(uint_test,inplace_multiplication_128_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint128_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint128_mul.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint128_t a,b,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        a *= b;
+        ASSERT_EQ(res_actual,a);
+    }
+}
+
+
+TEST(uint_test,addition_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint256_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint256_add.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint256_t a,b,res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a+b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,subtraction_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint256_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint256_sub.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint256_t a,b,res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a-b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,multiplication_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint256_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint256_mul.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint256_t a,b,res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a*b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,inplace_addition_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint256_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint256_add.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint256_t a,b,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        a += b;
+        ASSERT_EQ(res_actual,a);
+    }
+}
+
+
+TEST(uint_test,inplace_subtraction_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint256_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint256_sub.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint256_t a,b,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        a -= b;
+        ASSERT_EQ(res_actual,a);
+    }
+}
+
+
+TEST(uint_test,inplace_multiplication_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint256_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint256_mul.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint256_t a,b,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        a *= b;
+        ASSERT_EQ(res_actual,a);
+    }
+}
+
+
+TEST(uint_test,addition_512_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint512_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint512_add.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint512_t a,b,res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a+b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,subtraction_512_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint512_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint512_sub.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint512_t a,b,res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a-b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,multiplication_512_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint512_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint512_mul.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint512_t a,b,res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a*b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,inplace_addition_512_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint512_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint512_add.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint512_t a,b,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        a += b;
+        ASSERT_EQ(res_actual,a);
+    }
+}
+
+
+TEST(uint_test,inplace_subtraction_512_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint512_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint512_sub.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint512_t a,b,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        a -= b;
+        ASSERT_EQ(res_actual,a);
+    }
+}
+
+
+TEST(uint_test,inplace_multiplication_512_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint512_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint512_mul.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::uint512_t a,b,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        a *= b;
+        ASSERT_EQ(res_actual,a);
+    }
+}
+
+
+TEST(uint_test,addition_512_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint512_256_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint512_256_add.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::_uint<512,256> a,b;
+        lrf::_uint_add_out_t<512,256,512,256> res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a+b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,subtraction_512_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint512_256_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint512_256_sub.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::_uint<512,256> a,b;
+        lrf::_uint_sub_out_t<512,256,512,256> res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a-b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,multiplication_512_256_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::string test_samples_file_name(test_cases_dir+"uint512_256_samples.txt");
+    std::string test_res_file_name(test_cases_dir+"uint512_256_mul.txt");
+    std::ifstream fin_samples(test_samples_file_name),fin_res(test_res_file_name);
+    while(!fin_samples.eof() and !fin_res.eof())
+    {
+        lrf::_uint<512,256> a,b;
+        lrf::_uint_mul_out_t<512,256,512,256> res,res_actual;
+        fin_samples >> a >> b;
+        fin_res >> res_actual;
+        if(fin_samples.eof() or fin_res.eof()) break;
+        res = a*b;
+        ASSERT_EQ(res_actual,res);
+    }
+}
+
+
+TEST(uint_test,subtraction_narrow_minuend_test)
+{
+    // The borrow runs through the words the 256 bit minuend does not have
+    lrf::uint256_t a(0x10);
+    lrf::uint1024_t b(0x63d4);
+    ASSERT_EQ(lrf::uint1024_t(0) - lrf::uint1024_t(0x63c4),a-b);
+    ASSERT_EQ(lrf::uint1024_t(1) << 300,(lrf::uint1024_t(1) << 300) + lrf::uint256_t(0) - lrf::uint256_t(0));
+}
+
+
+TEST(uint_test,hash_test)
+{
+    std::string test_cases_dir(PROJECT_ROOT);
+    test_cases_dir += "/tests/cases/";
+    std::ifstream fin_samples(test_cases_dir+"uint512_samples.txt");
+    ASSERT_TRUE(fin_samples.is_open());
+    std::unordered_map<lrf::uint512_t,uint32_t> index;
+    std::unordered_set<std::size_t> hashes;
+    uint32_t samples_num = 0;
+    while(!fin_samples.eof())
+    {
+        lrf::uint512_t a;
+        fin_samples >> a;
+        if(fin_samples.eof()) break;
+        index.emplace(a,samples_num++);
+        hashes.insert(std::hash<lrf::uint512_t>()(a));
+        // Equal values hash equally across widths and views
+        lrf::_uint<1024> wide(a);
+        lrf::_uint_view<512> view(a.value);
+        ASSERT_EQ(std::hash<lrf::uint512_t>()(a),std::hash<lrf::_uint<1024>>()(wide));
+        ASSERT_EQ(std::hash<lrf::uint512_t>()(a),std::hash<lrf::_uint_view<512>>()(view));
+        typedef lrf::_uint<512,256> uint512_256_t;
+        uint512_256_t low(a);
+        ASSERT_EQ(std::hash<uint512_256_t>()(low),std::hash<lrf::uint256_t>()(lrf::uint256_t(a)));
+    }
+    ASSERT_EQ(index.size(),hashes.size());
+    typedef lrf::_uint<4096,2048> uint4096_2048_t;
+    ASSERT_EQ(lrf::_uint_hash()(lrf::uint128_t(0)),lrf::_uint_hash()(uint4096_2048_t(0)));
+
+    // Lookups with a different key width, without converting the key
+    typedef std::unordered_map<lrf::uint512_t,uint32_t,lrf::_uint_hash,std::equal_to<>> transparent_map;
+    transparent_map transparent_index(index.begin(),index.end());
+    for(const auto& [key,i] : index)
+    {
+        lrf::_uint<2048> wide(key);
+        auto it = transparent_index.find(wide);
+        ASSERT_TRUE(it != transparent_index.end());
+        ASSERT_EQ(i,it->second);
+    }
+    ASSERT_TRUE(transparent_index.find(lrf::_uint<2048>(1) << 600) == transparent_index.end());
+}